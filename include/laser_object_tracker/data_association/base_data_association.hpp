@@ -34,6 +34,8 @@
 #ifndef LASER_OBJECT_TRACKER_DATA_ASSOCIATION_BASE_DATA_ASSOCIATION_HPP
 #define LASER_OBJECT_TRACKER_DATA_ASSOCIATION_BASE_DATA_ASSOCIATION_HPP
 
+#include <vector>
+
 #include <Eigen/Core>
 
 namespace laser_object_tracker {
@@ -41,15 +43,29 @@ namespace data_association {
 
 class BaseDataAssociation {
  public:
+  /**
+   * @brief Accepts both owning matrices and maps of externally managed memory, without copying.
+   */
+  using CostMatrix = Eigen::Ref<const Eigen::MatrixXd>;
+
   static constexpr int NO_ASSIGNMENT = -1;
   static const Eigen::MatrixXd NOT_NEEDED;
 
   explicit BaseDataAssociation(double max_allowed_cost = std::numeric_limits<double>::infinity());
 
-  virtual double solve(const Eigen::MatrixXd& cost_matrix,
+  virtual double solve(const CostMatrix& cost_matrix,
                        const Eigen::MatrixXd& covariance_matrix,
                        Eigen::VectorXi& assignment_vector) = 0;
 
+  /**
+   * @brief Finds up to k lowest cost assignments, sorted by increasing cost.
+   * Default implementation returns only the single solution of solve().
+   */
+  virtual void solveKBest(const CostMatrix& cost_matrix,
+                          int k,
+                          std::vector<Eigen::VectorXi>& assignment_vectors,
+                          std::vector<double>& costs);
+
   virtual ~BaseDataAssociation() = default;
 
   double getMaxAllowedCost() const {
@@ -36,6 +36,7 @@
 
 #include "laser_object_tracker/data_association/base_data_association.hpp"
 #include "laser_object_tracker/data_association/hungarian_algorithm.hpp"
+#include "laser_object_tracker/data_association/murty_algorithm.hpp"
 #include "laser_object_tracker/data_association/naive_linear_assignment.hpp"
 
 #endif  // LASER_OBJECT_TRACKER_DATA_ASSOCIATION_DATA_ASSOCIATION_HPP
@@ -35,6 +35,7 @@
 #define LASER_OBJECT_TRACKER_DATA_ASSOCIATION_HUNGARIAN_ALGORITHM_HPP
 
 #include "laser_object_tracker/data_association/base_data_association.hpp"
+#include "laser_object_tracker/data_types/frame_arena.hpp"
 
 namespace Eigen {
 using ArrayXXb = Array<bool, Dynamic, Dynamic>;
@@ -47,40 +48,45 @@ namespace data_association {
 
 class HungarianAlgorithm : public BaseDataAssociation {
  public:
+  using ScratchArray = Eigen::Map<Eigen::ArrayXXd>;
+
   explicit HungarianAlgorithm(double max_allowed_cost = std::numeric_limits<double>::infinity());
 
-  double solve(const Eigen::MatrixXd& cost_matrix,
+  double solve(const CostMatrix& cost_matrix,
                const Eigen::MatrixXd& covariance_matrix,
                Eigen::VectorXi& assignment_vector) override;
 
  private:
-  double assignmentOptimal(const Eigen::MatrixXd& cost_matrix,
-                           Eigen::ArrayXXd& cost_matrix_copy,
+  double assignmentOptimal(const CostMatrix& cost_matrix,
+                           ScratchArray& cost_matrix_copy,
                            Eigen::VectorXi& assignment);
-  void buildAssignmentVector(const Eigen::MatrixXd& cost_matrix,
-                             Eigen::ArrayXXd& cost_matrix_copy,
+  void buildAssignmentVector(const CostMatrix& cost_matrix,
+                             ScratchArray& cost_matrix_copy,
                              Eigen::VectorXi& assignment);
-  double computeAssignmentCost(const Eigen::MatrixXd& cost_matrix,
-                               Eigen::ArrayXXd& cost_matrix_copy,
+  double computeAssignmentCost(const CostMatrix& cost_matrix,
+                               ScratchArray& cost_matrix_copy,
                                Eigen::VectorXi& assignment);
 
-  void step2a(const Eigen::MatrixXd& cost_matrix, Eigen::ArrayXXd& cost_matrix_copy, Eigen::VectorXi& assignment);
-  void step2b(const Eigen::MatrixXd& cost_matrix, Eigen::ArrayXXd& cost_matrix_copy, Eigen::VectorXi& assignment);
-  void step3(const Eigen::MatrixXd& cost_matrix, Eigen::ArrayXXd& cost_matrix_copy, Eigen::VectorXi& assignment);
-  void step4(const Eigen::MatrixXd& cost_matrix,
-             Eigen::ArrayXXd& cost_matrix_copy,
+  void step2a(const CostMatrix& cost_matrix, ScratchArray& cost_matrix_copy, Eigen::VectorXi& assignment);
+  void step2b(const CostMatrix& cost_matrix, ScratchArray& cost_matrix_copy, Eigen::VectorXi& assignment);
+  void step3(const CostMatrix& cost_matrix, ScratchArray& cost_matrix_copy, Eigen::VectorXi& assignment);
+  void step4(const CostMatrix& cost_matrix,
+             ScratchArray& cost_matrix_copy,
              Eigen::VectorXi& assignment,
              int row,
              int column);
-  void step5(const Eigen::MatrixXd& cost_matrix, Eigen::ArrayXXd& cost_matrix_copy, Eigen::VectorXi& assignment);
+  void step5(const CostMatrix& cost_matrix, ScratchArray& cost_matrix_copy, Eigen::VectorXi& assignment);
 
   bool isZero(double number, double precision = Eigen::NumTraits<double>::dummy_precision());
 
-  Eigen::ArrayXXb star_matrix_;
-  Eigen::ArrayXXb new_star_matrix_;
-  Eigen::ArrayXXb prime_matrix_;
-  Eigen::RowArrayXb covered_columns_;
-  Eigen::ArrayXb covered_rows_;
+  // Working copy of the costs and all masks live in the arena, which is rewound on every solve, so solving problems
+  // of any size up to the largest one seen so far does not allocate
+  data_types::FrameArena scratch_;
+  Eigen::Map<Eigen::ArrayXXb> star_matrix_{nullptr, 0, 0};
+  Eigen::Map<Eigen::ArrayXXb> new_star_matrix_{nullptr, 0, 0};
+  Eigen::Map<Eigen::ArrayXXb> prime_matrix_{nullptr, 0, 0};
+  Eigen::Map<Eigen::RowArrayXb> covered_columns_{nullptr, 0};
+  Eigen::Map<Eigen::ArrayXb> covered_rows_{nullptr, 0};
   Eigen::Index min_dimension_;
 };
 }  // namespace data_association
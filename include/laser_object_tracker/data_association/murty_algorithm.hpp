@@ -0,0 +1,145 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_DATA_ASSOCIATION_MURTY_ALGORITHM_HPP
+#define LASER_OBJECT_TRACKER_DATA_ASSOCIATION_MURTY_ALGORITHM_HPP
+
+#include <utility>
+#include <vector>
+
+#include "laser_object_tracker/data_association/base_data_association.hpp"
+
+namespace laser_object_tracker {
+namespace data_association {
+
+/**
+ * @brief K-best assignment solver based on Murty's partitioning.
+ * Subproblems are solved with shortest augmenting paths. Every child subproblem inherits assignment and dual
+ * variables of its parent, so it is re-solved with a single augmentation instead of a complete solve.
+ * Children are kept in the queue unsolved with a lower bound on their cost and are solved only when popped, until
+ * then they refer to the solution of their parent instead of holding a copy.
+ * Assignments are ranked by the cost of the complete assignment. Pairs exceeding max allowed cost are removed
+ * from the returned assignment vectors afterwards, same as in HungarianAlgorithm, and returned costs include only
+ * the remaining pairs, so they are not necessarily sorted.
+ */
+class MurtyAlgorithm : public BaseDataAssociation {
+ public:
+  explicit MurtyAlgorithm(double max_allowed_cost = std::numeric_limits<double>::infinity());
+
+  double solve(const CostMatrix& cost_matrix,
+               const Eigen::MatrixXd& covariance_matrix,
+               Eigen::VectorXi& assignment_vector) override;
+
+  void solveKBest(const CostMatrix& cost_matrix,
+                  int k,
+                  std::vector<Eigen::VectorXi>& assignment_vectors,
+                  std::vector<double>& costs) override;
+
+ private:
+  /**
+   * @brief Assignment and dual variables of a solved subproblem, kept in storage owned by the solver.
+   */
+  struct Solution {
+    std::vector<int> row_to_column;
+    std::vector<int> column_to_row;
+    std::vector<double> column_potentials;
+    // Number of subproblems in the queue referring to this solution
+    int references;
+  };
+
+  /**
+   * @brief Pair excluded from a subproblem, pairs of a subproblem form a list shared with its ancestors.
+   */
+  struct ForbiddenPair {
+    int row;
+    int column;
+    int previous;
+  };
+
+  struct Subproblem {
+    // Exact cost if solved, lower bound otherwise
+    double cost;
+    // Row which needs to be augmented, NO_ASSIGNMENT if solved
+    int free_row;
+    // Rows below keep the assignment of the solution, rows are fixed in order so they always form a prefix
+    int fixed_rows;
+    // Last pair of the forbidden list in forbidden_pairs_, NO_ASSIGNMENT if empty
+    int forbidden;
+    // Index in solutions_, for an unsolved subproblem it is the solution of its parent
+    int solution;
+  };
+
+  struct SubproblemCompare {
+    bool operator()(const Subproblem& lhs, const Subproblem& rhs) const;
+  };
+
+  void buildSquareCostMatrix(const CostMatrix& cost_matrix);
+  bool solveRoot(Subproblem& subproblem);
+  bool solveChild(Subproblem& subproblem);
+  bool augment(int free_row, int fixed_rows, Solution& solution);
+  double computeCost(const Solution& solution) const;
+  void partition(const Subproblem& parent);
+  void pushSubproblem(const Subproblem& subproblem);
+  Subproblem popSubproblem();
+  int acquireSolution();
+  void releaseSolution(int solution);
+  /**
+   * @return Sum of costs of pairs kept in the assignment vector
+   */
+  static double gatedCost(const CostMatrix& cost_matrix, const Eigen::VectorXi& assignment_vector);
+  void buildAssignmentVector(const CostMatrix& cost_matrix,
+                             const Solution& solution,
+                             Eigen::VectorXi& assignment_vector) const;
+
+  Eigen::MatrixXd square_cost_matrix_;
+  Eigen::Index rows_;
+  bool transposed_;
+
+  std::vector<Subproblem> queue_;
+
+  // Storage of subproblems reused between calls, children refer to it by index instead of copying their parent
+  std::vector<Solution> solutions_;
+  std::vector<int> free_solutions_;
+  std::vector<ForbiddenPair> forbidden_pairs_;
+
+  // Buffers reused between subproblems
+  Eigen::VectorXd distances_;
+  Eigen::VectorXi predecessors_;
+  std::vector<bool> done_columns_;
+  std::vector<int> scanned_columns_;
+  std::vector<double> forbidden_costs_;
+};
+}  // namespace data_association
+}  // namespace laser_object_tracker
+
+#endif //LASER_OBJECT_TRACKER_DATA_ASSOCIATION_MURTY_ALGORITHM_HPP
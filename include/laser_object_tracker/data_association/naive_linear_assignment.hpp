@@ -43,7 +43,7 @@ class NaiveLinearAssignment : public BaseDataAssociation {
  public:
   explicit NaiveLinearAssignment(double max_allowed_cost = std::numeric_limits<double>::infinity());
 
-  double solve(const Eigen::MatrixXd& cost_matrix,
+  double solve(const CostMatrix& cost_matrix,
                const Eigen::MatrixXd& covariance_matrix,
                Eigen::VectorXi& assignment_vector) override;
 };
@@ -35,6 +35,10 @@
 #define LASER_OBJECT_TRACKER_DATA_TYPES_DATA_TYPES_HPP
 
 #include "laser_object_tracker/data_types/definitions.hpp"
+#include "laser_object_tracker/data_types/frame_arena.hpp"
 #include "laser_object_tracker/data_types/laser_scan_fragment.hpp"
+#include "laser_object_tracker/data_types/oriented_bounding_box.hpp"
+#include "laser_object_tracker/data_types/region_of_interest.hpp"
+#include "laser_object_tracker/data_types/segment_descriptor.hpp"
 
 #endif  // LASER_OBJECT_TRACKER_DATA_TYPES_DATA_TYPES_HPP
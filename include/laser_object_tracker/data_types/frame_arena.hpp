@@ -0,0 +1,122 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_DATA_TYPES_FRAME_ARENA_HPP
+#define LASER_OBJECT_TRACKER_DATA_TYPES_FRAME_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace laser_object_tracker {
+namespace data_types {
+
+/**
+ * @brief Monotonic allocator for memory which lives no longer than a single frame.
+ * Allocation only bumps an offset and nothing is freed until reset(), which rewinds the offset in O(1).
+ * If a frame does not fit into the current block, additional blocks are allocated and on the next reset they are
+ * replaced by a single block large enough for the whole frame, so after warm-up the arena does not allocate.
+ */
+class FrameArena {
+ public:
+  explicit FrameArena(size_t capacity = 0) : block_(capacity > 0 ? new char[capacity] : nullptr),
+                                             capacity_(capacity) {}
+
+  FrameArena(const FrameArena&) = delete;
+
+  FrameArena& operator=(const FrameArena&) = delete;
+
+  /**
+   * @brief Returns uninitialized memory valid until the next reset.
+   */
+  void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+    size_t offset = (offset_ + alignment - 1) / alignment * alignment;
+    if (offset + bytes <= capacity_) {
+      offset_ = offset + bytes;
+      return block_.get() + offset;
+    }
+
+    // Memory returned by new[] is aligned for any fundamental type
+    overflow_blocks_.emplace_back(new char[bytes]);
+    overflow_bytes_ += bytes + alignment;
+    return overflow_blocks_.back().get();
+  }
+
+  /**
+   * @brief Returns uninitialized storage for count objects of type T, valid until the next reset.
+   */
+  template<class T>
+  T* allocate(size_t count) {
+    return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+  }
+
+  /**
+   * @brief Invalidates all memory returned so far.
+   */
+  void reset() {
+    if (!overflow_blocks_.empty()) {
+      capacity_ += overflow_bytes_;
+      block_.reset(new char[capacity_]);
+      overflow_blocks_.clear();
+      overflow_bytes_ = 0;
+    }
+
+    offset_ = 0;
+  }
+
+  /**
+   * @return Size of the block, which is reused between frames
+   */
+  size_t capacity() const {
+    return capacity_;
+  }
+
+  /**
+   * @return Number of bytes allocated from the block since the last reset
+   */
+  size_t used() const {
+    return offset_;
+  }
+
+ private:
+  std::unique_ptr<char[]> block_;
+  size_t capacity_;
+  size_t offset_ = 0;
+
+  std::vector<std::unique_ptr<char[]>> overflow_blocks_;
+  size_t overflow_bytes_ = 0;
+};
+}  // namespace data_types
+}  // namespace laser_object_tracker
+
+#endif  // LASER_OBJECT_TRACKER_DATA_TYPES_FRAME_ARENA_HPP
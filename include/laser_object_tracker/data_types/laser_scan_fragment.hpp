@@ -39,6 +39,8 @@
 
 // PROJECT
 #include "laser_object_tracker/data_types/definitions.hpp"
+#include "laser_object_tracker/data_types/region_of_interest.hpp"
+#include "laser_object_tracker/data_types/segment_descriptor.hpp"
 
 namespace laser_object_tracker {
 namespace data_types {
@@ -74,6 +76,18 @@ class LaserScanFragment {
      */
     LaserScanFragment fromLaserScan(LaserScanType&& laser_scan);
 
+    /**
+     * @brief Beams outside of the region are marked as having no return before projection, so that they are
+     * skipped by all further stages. Indices of beams are kept.
+     */
+    void setRegionOfInterest(const RegionOfInterest& region_of_interest) {
+      region_of_interest_ = region_of_interest;
+    }
+
+    const RegionOfInterest& getRegionOfInterest() const {
+      return region_of_interest_;
+    }
+
    private:
     /**
      * @brief Given fragment with initialized laser_scan, initialize rest of the fields
@@ -82,6 +96,7 @@ class LaserScanFragment {
     void completeInitialization(LaserScanFragment& fragment);
 
     laser_geometry::LaserProjection laser_projector_;
+    RegionOfInterest region_of_interest_;
   };
 
   /**
@@ -105,6 +120,29 @@ class LaserScanFragment {
    */
   LaserScanFragment(const LaserScanFragment& other, long first, long last);
 
+  /**
+   * @brief Same as above, with descriptor of the range already computed, e.g. during segmentation
+   * @param descriptor Descriptor of points in the range, taken as is
+   */
+  LaserScanFragment(const LaserScanFragment& other, long first, long last, const SegmentDescriptor& descriptor);
+
+  /**
+   * @brief Constructs the container by joining two fragments, e.g. segments on both sides of the seam of a full
+   * revolution scan. Elements of the second one follow those of the first one with the angle increment of the first
+   * one, so their angles may exceed angle max of the original scan.
+   * @param first Fragment providing header, angle min and the leading elements
+   * @param second Fragment providing the trailing elements
+   */
+  LaserScanFragment(const LaserScanFragment& first, const LaserScanFragment& second);
+
+  /**
+   * @brief Constructs the container by joining fragments of the same scan ordered by bearing, which may be separated by
+   * beams of other fragments, e.g. parts of an object partially occluded by a closer one. Elements keep their angles,
+   * which are stored explicitly if the fragments are not neighbours.
+   * @param fragments Fragments to be joined, the first one provides header and angle increment
+   */
+  explicit LaserScanFragment(const std::vector<const LaserScanFragment*>& fragments);
+
   /**
    *
    * @return Header of LaserScanType measurement
@@ -154,13 +192,22 @@ class LaserScanFragment {
   }
 
   /**
-   * @brief Accessor to the underlying LaserScanType data.
+   * @brief Accessor to the underlying LaserScanType data. Ranges are spaced by the angle increment only if
+   * hasEvenlySpacedAngles() is true, otherwise angles of ranges are given by elements.
    * @return Underlying LaserScanType data.
    */
   const LaserScanType& laserScan() const {
     return laser_scan_;
   }
 
+  /**
+   *
+   * @return False if the fragment joins fragments separated by other beams, so angles of elements are stored explicitly
+   */
+  bool hasEvenlySpacedAngles() const {
+    return angles_.empty();
+  }
+
   /**
    * @brief Accessor to the underlying OcclusionType data.
    * @return Underlying OcclusionType data.
@@ -233,6 +280,13 @@ class LaserScanFragment {
 
   bool isValid() const;
 
+  /**
+   * @brief Geometric descriptor of the fragment. Computed when the fragment is cut out of a larger one or on the first
+   * call, then cached and carried over by copies, so points should not be modified after that.
+   * @return Descriptor of all finite points of the fragment
+   */
+  const SegmentDescriptor& descriptor() const;
+
  private:
   /**
    * @brief This method clear and initializes internal elements_ container
@@ -243,7 +297,20 @@ class LaserScanFragment {
   OcclusionType occlusion_vector_;
   PointCloudType laser_scan_cloud_;
   ContainerType elements_;
+  // Angles of elements, if they are not evenly spaced, empty otherwise
+  std::vector<double> angles_;
+
+  mutable SegmentDescriptor descriptor_;
+  mutable bool descriptor_computed_ = false;
 };
+
+/**
+ * @brief Flags the closer of the neighbouring ends of consecutive fragments, as well as the first and the last end.
+ * Only boundary elements are accessed, so segmentation can flag the segments it emits without another pass.
+ * @param fragments Fragments ordered by bearing
+ * @param max_angle_gap Ends of fragments further apart in bearing are not compared
+ */
+void flagOcclusions(std::vector<LaserScanFragment>& fragments, double max_angle_gap);
 }  // namespace data_types
 }  // namespace laser_object_tracker
 
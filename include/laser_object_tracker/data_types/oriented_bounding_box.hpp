@@ -0,0 +1,116 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_DATA_TYPES_ORIENTED_BOUNDING_BOX_HPP
+#define LASER_OBJECT_TRACKER_DATA_TYPES_ORIENTED_BOUNDING_BOX_HPP
+
+// STD
+#include <vector>
+
+// EIGEN
+#include <Eigen/Core>
+
+namespace laser_object_tracker {
+namespace data_types {
+
+// Unaligned types, so descriptors can be stored in standard containers without aligned allocators
+using DescriptorVector = Eigen::Matrix<double, 2, 1, Eigen::DontAlign>;
+using DescriptorMatrix = Eigen::Matrix<double, 2, 2, Eigen::DontAlign>;
+
+/**
+ * @brief Minimal-area rectangle enclosing a set of points.
+ */
+struct OrientedBoundingBox {
+  DescriptorVector center = DescriptorVector::Zero();
+  /** @brief Length of the side along angle and of the perpendicular side */
+  DescriptorVector size = DescriptorVector::Zero();
+  /** @brief Orientation of the first side with respect to the x axis, in radians */
+  double angle = 0.0;
+
+  double area() const {
+    return size(0) * size(1);
+  }
+};
+
+/**
+ * @brief Computes minimal-area rectangle of points ordered by bearing, as seen from the sensor.
+ *
+ * Such points form a simple polyline, so their convex hull is built in linear time with Melkman's algorithm instead
+ * of sorting them, and rotating calipers are run on the hull afterwards. Points and hull are stored as separate x and y
+ * arrays which are kept between calls, so no allocation happens once they have grown to the largest segment.
+ */
+class OrientedBoundingBoxCalculator {
+ public:
+  /**
+   * @brief Removes all points added so far, keeping allocated memory.
+   */
+  void clear();
+
+  /**
+   * @brief Appends point to the polyline. Points have to be added in the order of their bearing.
+   */
+  void addPoint(float x, float y);
+
+  /**
+   * @brief Number of points added since last clear.
+   */
+  long size() const {
+    return x_.size();
+  }
+
+  /**
+   * @brief Computes rectangle of the points added so far. Zero-sized box is returned for no points.
+   * @param obb Output rectangle
+   */
+  void compute(OrientedBoundingBox& obb);
+
+ private:
+  /**
+   * @brief Fills deque of hull points with Melkman's algorithm.
+   * @param hull_begin Output index of the first hull point in hull_x_ and hull_y_
+   * @param hull_size Output number of hull points, in counter-clockwise order
+   * @return False if all points are collinear and the hull is degenerated
+   */
+  bool buildHull(long& hull_begin, long& hull_size);
+
+  void computeCollinear(OrientedBoundingBox& obb) const;
+
+  void rotatingCalipers(long hull_begin, long hull_size, OrientedBoundingBox& obb) const;
+
+  std::vector<float> x_, y_;
+  std::vector<float> hull_x_, hull_y_;
+};
+}  // namespace data_types
+}  // namespace laser_object_tracker
+
+#endif  // LASER_OBJECT_TRACKER_DATA_TYPES_ORIENTED_BOUNDING_BOX_HPP
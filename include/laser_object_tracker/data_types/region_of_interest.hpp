@@ -0,0 +1,117 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_DATA_TYPES_REGION_OF_INTEREST_HPP
+#define LASER_OBJECT_TRACKER_DATA_TYPES_REGION_OF_INTEREST_HPP
+
+// STD
+#include <limits>
+#include <utility>
+#include <vector>
+
+// EIGEN
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+// PROJECT
+#include "laser_object_tracker/data_types/definitions.hpp"
+
+namespace laser_object_tracker {
+namespace data_types {
+
+/**
+ * @brief Part of the scanner field of view, which is processed. Beam is kept if its angle lies in any of angle windows,
+ * its range is within range limits and its point lies inside the polygon given in the sensor frame. Empty set of
+ * windows or empty polygon do not restrict beams. Default constructed region keeps every beam.
+ */
+class RegionOfInterest {
+ public:
+  using Polygon = std::vector<Eigen::Vector2d, Eigen::aligned_allocator<Eigen::Vector2d>>;
+
+  /**
+   * @brief Adds window [angle_min, angle_max] of kept beam angles.
+   */
+  void addAngleWindow(double angle_min, double angle_max);
+
+  void setRangeLimits(double min_range, double max_range);
+
+  /**
+   * @brief Sets polygon with vertices in order, either clockwise or counterclockwise.
+   */
+  void setPolygon(const Polygon& polygon);
+
+  /**
+   * @brief Sets ranges of excluded beams to +inf, e.g. no return, keeping indices of all beams.
+   * Excluded beams are then neither projected nor segmented. Beams with invalid ranges, that is NaN or outside of
+   * range limits of the scan, are left untouched.
+   * @return Number of kept beams with valid ranges
+   */
+  long apply(LaserScanType& laser_scan) const;
+
+  bool containsAngle(double angle) const;
+
+  bool containsRange(double range) const;
+
+  bool containsPoint(const Eigen::Vector2d& point) const;
+
+  /**
+   * @return True if the region does not exclude any beam
+   */
+  bool isUnbounded() const;
+
+  const std::vector<std::pair<double, double>>& getAngleWindows() const {
+    return angle_windows_;
+  }
+
+  double getMinRange() const {
+    return min_range_;
+  }
+
+  double getMaxRange() const {
+    return max_range_;
+  }
+
+  const Polygon& getPolygon() const {
+    return polygon_;
+  }
+
+ private:
+  std::vector<std::pair<double, double>> angle_windows_;
+  double min_range_ = 0.0;
+  double max_range_ = std::numeric_limits<double>::infinity();
+  Polygon polygon_;
+};
+}  // namespace data_types
+}  // namespace laser_object_tracker
+
+#endif  // LASER_OBJECT_TRACKER_DATA_TYPES_REGION_OF_INTEREST_HPP
@@ -0,0 +1,111 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_DATA_TYPES_SEGMENT_DESCRIPTOR_HPP
+#define LASER_OBJECT_TRACKER_DATA_TYPES_SEGMENT_DESCRIPTOR_HPP
+
+// PROJECT
+#include "laser_object_tracker/data_types/definitions.hpp"
+#include "laser_object_tracker/data_types/oriented_bounding_box.hpp"
+
+namespace laser_object_tracker {
+namespace data_types {
+
+/**
+ * @brief Geometric summary of a segment, computed once and shared by filters, feature extractors and visualization.
+ * Non-finite points are skipped, all other members are zero for a segment without finite points.
+ */
+struct SegmentDescriptor {
+  /** @brief Number of finite points the descriptor was computed from */
+  long points_number = 0;
+  DescriptorVector centroid = DescriptorVector::Zero();
+  /** @brief Population covariance of the points */
+  DescriptorMatrix covariance = DescriptorMatrix::Zero();
+  /** @brief Axis-aligned bounding box corners */
+  DescriptorVector min = DescriptorVector::Zero();
+  DescriptorVector max = DescriptorVector::Zero();
+  OrientedBoundingBox obb;
+  /** @brief Distance between the first and the last finite point */
+  double extent = 0.0;
+};
+
+/**
+ * @brief Running moments, axis-aligned and oriented bounding boxes of points streamed one by one, so that the descriptor
+ * can be computed within another pass over the scan, e.g. segmentation.
+ */
+class SegmentDescriptorAccumulator {
+ public:
+  /**
+   * @brief Removes all points added so far, keeping allocated memory.
+   */
+  void clear();
+
+  /**
+   * @brief Adds point to the descriptor, non-finite points are skipped. Points have to be added in the order of their
+   * bearing.
+   */
+  void add(const PointCloudType::PointType& point);
+
+  /**
+   * @brief Computes descriptor of the points added since last clear.
+   * @param descriptor Output descriptor
+   */
+  void compute(SegmentDescriptor& descriptor);
+
+ private:
+  long points_number_ = 0;
+  // Moments are accumulated relative to the first finite point to avoid cancellation far from the sensor
+  double reference_x_ = 0.0, reference_y_ = 0.0;
+  double sum_x_ = 0.0, sum_y_ = 0.0, sum_xx_ = 0.0, sum_xy_ = 0.0, sum_yy_ = 0.0;
+  double min_x_ = 0.0, min_y_ = 0.0, max_x_ = 0.0, max_y_ = 0.0;
+  double last_x_ = 0.0, last_y_ = 0.0;
+  OrientedBoundingBoxCalculator obb_calculator_;
+};
+
+/**
+ * @brief Computes all members of the descriptor in a single pass over the points.
+ * @param points Points of the segment, ordered by bearing as in every LaserScanFragment
+ * @param descriptor Output descriptor
+ * @param accumulator Accumulator whose scratch buffers are reused for the oriented bounding box
+ */
+void computeSegmentDescriptor(const PointCloudType& points, SegmentDescriptor& descriptor,
+                              SegmentDescriptorAccumulator& accumulator);
+
+/**
+ * @brief Same as above, using an accumulator local to the calling thread.
+ */
+void computeSegmentDescriptor(const PointCloudType& points, SegmentDescriptor& descriptor);
+}  // namespace data_types
+}  // namespace laser_object_tracker
+
+#endif  // LASER_OBJECT_TRACKER_DATA_TYPES_SEGMENT_DESCRIPTOR_HPP
@@ -34,27 +34,75 @@
 #ifndef LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_BASE_FEATURE_EXTRACTION_HPP
 #define LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_BASE_FEATURE_EXTRACTION_HPP
 
+#include <cstddef>
+#include <memory>
+
 #include "laser_object_tracker/data_types/laser_scan_fragment.hpp"
+#include "laser_object_tracker/feature_extraction/segment_decimation.hpp"
 
 namespace laser_object_tracker {
 namespace feature_extraction {
 
 class BaseFeatureExtraction {
  public:
+  /**
+   * @brief Non-owning view of x and y coordinates of points, stored in columns.
+   */
+  using PointsView = Eigen::Map<const Eigen::Matrix2Xf, Eigen::Unaligned, Eigen::OuterStride<>>;
+
   virtual bool extractFeature(const data_types::LaserScanFragment& fragment, Eigen::VectorXd& feature) = 0;
 
   virtual ~BaseFeatureExtraction() = default;
 
+  /**
+   * @brief Makes the extractor process points of fragments thinned by the decimation, nullptr restores all points.
+   */
+  void setDecimation(std::shared_ptr<const SegmentDecimation> decimation) {
+    decimation_ = std::move(decimation);
+  }
+
+  const std::shared_ptr<const SegmentDecimation>& getDecimation() const {
+    return decimation_;
+  }
+
  protected:
   void fragmentToEigenMatrix(const data_types::LaserScanFragment& fragment,
                              Eigen::MatrixX2d& matrix) {
-    matrix.resize(fragment.size(), 2);
+    matrix = fragmentPoints(fragment).transpose().cast<double>();
+  }
 
-    for (int i = 0; i < fragment.size(); ++i) {
-      matrix(i, 0) = fragment.at(i).point().x;
-      matrix(i, 1) = fragment.at(i).point().y;
+  /**
+   * @brief Points processed by the extractor, either all points of the fragment or those kept by the decimation.
+   * View is valid as long as the fragment is not modified and no other fragment is passed to this method.
+   */
+  PointsView fragmentPoints(const data_types::LaserScanFragment& fragment) {
+    if (!decimation_) {
+      return fragmentPointsView(fragment);
     }
+
+    long size = decimation_->decimate(fragment, decimated_points_);
+    return PointsView(decimated_points_.data(), 2, size, Eigen::OuterStride<>(2));
+  }
+
+  /**
+   * @brief Views coordinates of fragment points directly in its point cloud, without copying them.
+   * View is valid as long as the fragment is not modified.
+   */
+  static PointsView fragmentPointsView(const data_types::LaserScanFragment& fragment) {
+    using PointType = data_types::PointCloudType::PointType;
+    static_assert(offsetof(PointType, y) == offsetof(PointType, x) + sizeof(float),
+                  "Point coordinates need to be stored next to each other.");
+
+    const auto& points = fragment.pointCloud().points;
+    return PointsView(points.empty() ? nullptr : &points.front().x,
+                      2,
+                      points.size(),
+                      Eigen::OuterStride<>(sizeof(PointType) / sizeof(float)));
   }
+
+ private:
+  std::shared_ptr<const SegmentDecimation> decimation_;
+  Eigen::Matrix2Xf decimated_points_;
 };
 }  // namespace feature_extraction
 }  // namespace laser_object_tracker
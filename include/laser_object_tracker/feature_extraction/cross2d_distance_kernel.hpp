@@ -0,0 +1,82 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_CROSS2D_DISTANCE_KERNEL_HPP
+#define LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_CROSS2D_DISTANCE_KERNEL_HPP
+
+#include <Eigen/Core>
+
+namespace laser_object_tracker {
+namespace feature_extraction {
+
+/**
+ * @brief Corner and unit direction of its first arm (x, y, dx, dy), the second arm is directed along (dy, -dx).
+ */
+using Cross2DCoefficients = Eigen::Matrix<float, 4, 1, Eigen::DontAlign>;
+
+/**
+ * @brief Squared distances of points to the closer arm of the corner.
+ * Points are passed as separate x and y arrays. On CPUs supporting AVX2, 8 points are processed per instruction,
+ * otherwise the same arithmetic is evaluated one point at a time, so both give identical results.
+ */
+void computeCross2DSquaredDistances(const Cross2DCoefficients& coefficients,
+                                    const float* x,
+                                    const float* y,
+                                    int count,
+                                    float* squared_distances);
+
+/**
+ * @brief Counts points with squared distance below squared_threshold, no square root is taken.
+ */
+int countCross2DWithinDistance(const Cross2DCoefficients& coefficients,
+                               const float* x,
+                               const float* y,
+                               int count,
+                               float squared_threshold);
+
+/**
+ * @brief Stores positions and squared distances of points closer than the threshold, in increasing order of position.
+ * Both output arrays need space for count elements.
+ * @return Number of selected points
+ */
+int selectCross2DWithinDistance(const Cross2DCoefficients& coefficients,
+                                const float* x,
+                                const float* y,
+                                int count,
+                                float squared_threshold,
+                                int* selected,
+                                float* squared_distances);
+}  // namespace feature_extraction
+}  // namespace laser_object_tracker
+
+#endif  // LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_CROSS2D_DISTANCE_KERNEL_HPP
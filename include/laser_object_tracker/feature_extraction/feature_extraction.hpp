@@ -37,8 +37,15 @@
 #include "laser_object_tracker/feature_extraction/features/features.hpp"
 #include "laser_object_tracker/feature_extraction/pcl/sac_model_cross2d.hpp"
 #include "laser_object_tracker/feature_extraction/base_feature_extraction.hpp"
+#include "laser_object_tracker/feature_extraction/cross2d_distance_kernel.hpp"
+#include "laser_object_tracker/feature_extraction/incremental_segment_detection.hpp"
+#include "laser_object_tracker/feature_extraction/line_moments.hpp"
+#include "laser_object_tracker/feature_extraction/principal_component_corner_detection.hpp"
 #include "laser_object_tracker/feature_extraction/random_sample_consensus_corner_detection.hpp"
 #include "laser_object_tracker/feature_extraction/random_sample_consensus_segment_detection.hpp"
+#include "laser_object_tracker/feature_extraction/sample_consensus_2d.hpp"
+#include "laser_object_tracker/feature_extraction/sample_consensus_model_2d.hpp"
 #include "laser_object_tracker/feature_extraction/search_based_corner_detection.hpp"
+#include "laser_object_tracker/feature_extraction/segment_decimation.hpp"
 
 #endif  // LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_FEATURE_EXTRACTION_HPP
@@ -0,0 +1,96 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_INCREMENTAL_SEGMENT_DETECTION_HPP
+#define LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_INCREMENTAL_SEGMENT_DETECTION_HPP
+
+#include <vector>
+
+#include "laser_object_tracker/feature_extraction/base_feature_extraction.hpp"
+#include "laser_object_tracker/feature_extraction/features/features.hpp"
+#include "laser_object_tracker/feature_extraction/line_moments.hpp"
+
+namespace laser_object_tracker {
+namespace feature_extraction {
+
+/**
+ * @brief Deterministic line extraction from points ordered by bearing, linear in the number of points.
+ * A line grows point by point, until the next point is farther than distance threshold from the line fitted so far.
+ * Then neighbouring lines are merged, if RMS distance of their points to a common line is within distance threshold.
+ * Every fit is updated in constant time from running moments. Lines supported by fewer than min points are dropped.
+ */
+class IncrementalSegmentDetection : public BaseFeatureExtraction {
+ public:
+  IncrementalSegmentDetection(double distance_threshold, int min_points);
+
+  /**
+   * @brief Feature holds coefficients of consecutive features::Segment2D, 4 per segment, in order of points.
+   * @return False if no line has enough points
+   */
+  bool extractFeature(const data_types::LaserScanFragment& fragment, Eigen::VectorXd& feature) override;
+
+  /**
+   * @brief Extracts lines of the fragment directly into segments, which are cleared first.
+   * @return False if no line has enough points
+   */
+  bool extractSegments(const data_types::LaserScanFragment& fragment, features::Segments2D& segments);
+
+  double getDistanceThreshold() const;
+
+  void setDistanceThreshold(double distance_threshold);
+
+  int getMinPoints() const;
+
+  void setMinPoints(int min_points);
+
+ private:
+  struct Line {
+    int begin;
+    int end;
+    LineMoments moments;
+  };
+
+  void splitLines(const PointsView& points, const Eigen::Vector2d& origin);
+
+  void mergeLines();
+
+  double distance_threshold_;
+  int min_points_;
+
+  std::vector<Line> lines_;
+  features::Segments2D segments_;
+};
+}  // namespace feature_extraction
+}  // namespace laser_object_tracker
+
+#endif  // LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_INCREMENTAL_SEGMENT_DETECTION_HPP
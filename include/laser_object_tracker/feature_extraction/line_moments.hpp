@@ -0,0 +1,132 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_LINE_MOMENTS_HPP
+#define LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_LINE_MOMENTS_HPP
+
+#include <cmath>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+namespace laser_object_tracker {
+namespace feature_extraction {
+
+/**
+ * @brief Running sums of coordinates of points, enough to fit a total least squares line in constant time.
+ * Moments of disjoint point sets are combined by addition and split by subtraction. Coordinates should be relative
+ * to a point near the set, so that sums of squares do not lose precision far from the sensor.
+ */
+struct LineMoments {
+  void add(double px, double py) {
+    xx += px * px;
+    xy += px * py;
+    yy += py * py;
+    x += px;
+    y += py;
+    ++n;
+  }
+
+  LineMoments operator+(const LineMoments& other) const {
+    LineMoments sum;
+    sum.xx = xx + other.xx;
+    sum.xy = xy + other.xy;
+    sum.yy = yy + other.yy;
+    sum.x = x + other.x;
+    sum.y = y + other.y;
+    sum.n = n + other.n;
+
+    return sum;
+  }
+
+  LineMoments operator-(const LineMoments& other) const {
+    LineMoments difference;
+    difference.xx = xx - other.xx;
+    difference.xy = xy - other.xy;
+    difference.yy = yy - other.yy;
+    difference.x = x - other.x;
+    difference.y = y - other.y;
+    difference.n = n - other.n;
+
+    return difference;
+  }
+
+  Eigen::Vector2d centroid() const {
+    return Eigen::Vector2d(x, y) / n;
+  }
+
+  /**
+   * @brief Sum of squared distances of points to the fitted line, e.g. the smallest eigenvalue of the scatter matrix.
+   */
+  double residual() const {
+    if (n < 2) {
+      return 0.0;
+    }
+
+    double s_xx = xx - x * x / n;
+    double s_xy = xy - x * y / n;
+    double s_yy = yy - y * y / n;
+
+    double half_trace = 0.5 * (s_xx + s_yy);
+    double half_difference = 0.5 * (s_xx - s_yy);
+    return std::max(half_trace - std::sqrt(half_difference * half_difference + s_xy * s_xy), 0.0);
+  }
+
+  /**
+   * @brief Unit direction of the fitted line, e.g. the eigenvector of the largest eigenvalue of the scatter matrix.
+   */
+  Eigen::Vector2d direction() const {
+    double s_xx = xx - x * x / n;
+    double s_xy = xy - x * y / n;
+    double s_yy = yy - y * y / n;
+
+    double angle = 0.5 * std::atan2(2.0 * s_xy, s_xx - s_yy);
+    return Eigen::Vector2d(std::cos(angle), std::sin(angle));
+  }
+
+  Eigen::Hyperplane<double, 2> line() const {
+    Eigen::Vector2d point = centroid();
+    return Eigen::Hyperplane<double, 2>::Through(point, point + direction());
+  }
+
+  double xx = 0.0;
+  double xy = 0.0;
+  double yy = 0.0;
+  double x = 0.0;
+  double y = 0.0;
+  int n = 0;
+};
+}  // namespace feature_extraction
+}  // namespace laser_object_tracker
+
+#endif  // LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_LINE_MOMENTS_HPP
@@ -36,9 +36,10 @@
 
 #include <pcl/common/concatenate.h>
 #include <pcl/common/distances.h>
-#include <pcl/sample_consensus/eigen.h>
 #include <pcl/sample_consensus/sac_model.h>
 
+#include "laser_object_tracker/feature_extraction/cross2d_distance_kernel.hpp"
+
 namespace pcl {
 
 template<typename PointT>
@@ -56,12 +57,16 @@ class SampleConsenusModelCross2D : public SampleConsensusModel<PointT> {
   using CosntPtr = boost::shared_ptr<const SampleConsenusModelCross2D>;
 
   explicit SampleConsenusModelCross2D(const PointCloudConstPtr& cloud, bool random = false) :
-      SampleConsensusModel<PointT>(cloud, random) {}
+      SampleConsensusModel<PointT>(cloud, random) {
+    updateCoordinates();
+  }
 
   SampleConsenusModelCross2D(const PointCloudConstPtr& cloud,
                              const std::vector<int>& indices,
                              bool random = false) :
-      SampleConsensusModel<PointT>(cloud, indices, random) {}
+      SampleConsensusModel<PointT>(cloud, indices, random) {
+    updateCoordinates();
+  }
 
   SampleConsenusModelCross2D(const SampleConsenusModelCross2D& other) :
       SampleConsensusModel<PointT>(SampleConsenusModelCross2D()) {}
@@ -73,6 +78,11 @@ class SampleConsenusModelCross2D : public SampleConsensusModel<PointT> {
     return *this;
   }
 
+  void setInputCloud(const PointCloudConstPtr& cloud) override {
+    SampleConsensusModel<PointT>::setInputCloud(cloud);
+    updateCoordinates();
+  }
+
   bool computeModelCoefficients(const std::vector<int>& samples, Eigen::VectorXf& model_coefficients) override {
     if (samples.size() != 3) {
       PCL_ERROR ("[pcl::SampleConsensusModelCross2D::computeModelCoefficients] Invalid set of samples given (%lu)!\n",
@@ -131,17 +141,22 @@ class SampleConsenusModelCross2D : public SampleConsensusModel<PointT> {
       return;
     }
 
-    tmp_inliers_ = &inliers;
+    inlier_x_.resize(inliers.size());
+    inlier_y_.resize(inliers.size());
+    for (size_t i = 0; i < inliers.size(); ++i) {
+      inlier_x_[i] = input_->points[inliers[i]].x;
+      inlier_y_[i] = input_->points[inliers[i]].y;
+    }
 
-    OptimizationFunctor functor(inliers.size(), this);
-    Eigen::NumericalDiff<OptimizationFunctor> numerical_diff(functor);
-    Eigen::LevenbergMarquardt<Eigen::NumericalDiff<OptimizationFunctor>, float> levenberg_marquardt(numerical_diff);
-    int info = levenberg_marquardt.minimize(optimized_coefficients);
+    Eigen::Vector4f coefficients = model_coefficients.head<4>();
+    float residual_norm = 0.0f;
+    int info = levenbergMarquardt(coefficients, residual_norm);
+    optimized_coefficients = coefficients;
 
     PCL_DEBUG (
         "[pcl::SampleConsensusModelCross2D::optimizeModelCoefficients] LM solver finished with exit code %i, having a residual norm of %g. \nInitial solution: %g %g %g %g \nFinal solution: %g %g %g %g\n",
         info,
-        levenberg_marquardt.fvec.norm(),
+        residual_norm,
         model_coefficients[0],
         model_coefficients[1],
         model_coefficients[2],
@@ -161,19 +176,14 @@ class SampleConsenusModelCross2D : public SampleConsensusModel<PointT> {
       return;
     }
 
+    updateCoordinatesIfNeeded();
     distances.resize(indices_->size());
+    squared_distances_.resize(indices_->size());
+    laser_object_tracker::feature_extraction::computeCross2DSquaredDistances(
+        kernelCoefficients(model_coefficients), x_.data(), y_.data(), x_.size(), squared_distances_.data());
 
-    Eigen::Vector4f corner_point(model_coefficients[0], model_coefficients[1], 0.0, 0.0);
-    Eigen::Vector4f line_1_direction(model_coefficients[2], model_coefficients[3], 0.0, 0.0);
-    Eigen::Vector4f line_2_direction(model_coefficients[3], -model_coefficients[2], 0.0, 0.0);
-    line_1_direction.normalize();
-    line_2_direction.normalize();
-
-    Eigen::Vector4f point;
-    for (size_t i = 0; i < indices_->size(); ++i) {
-      pointToEigenVector(input_->points[(*indices_)[i]], point);
-      distances[i] = std::sqrt(std::min(sqrPointToLineDistance(point, corner_point, line_1_direction),
-                                        sqrPointToLineDistance(point, corner_point, line_2_direction)));
+    for (size_t i = 0; i < squared_distances_.size(); ++i) {
+      distances[i] = std::sqrt(squared_distances_[i]);
     }
   }
 
@@ -187,31 +197,19 @@ class SampleConsenusModelCross2D : public SampleConsensusModel<PointT> {
       return;
     }
 
-    double squared_threshold = threshold * threshold;
+    updateCoordinatesIfNeeded();
     inliers.resize(indices_->size());
-    error_sqr_dists_.resize(indices_->size());
+    squared_distances_.resize(indices_->size());
+    int point_number = laser_object_tracker::feature_extraction::selectCross2DWithinDistance(
+        kernelCoefficients(model_coefficients), x_.data(), y_.data(), x_.size(), threshold * threshold,
+        inliers.data(), squared_distances_.data());
 
-    Eigen::Vector4f corner_point(model_coefficients[0], model_coefficients[1], 0.0, 0.0);
-    Eigen::Vector4f line_1_direction(model_coefficients[2], model_coefficients[3], 0.0, 0.0);
-    Eigen::Vector4f line_2_direction(model_coefficients[3], -model_coefficients[2], 0.0, 0.0);
-    line_1_direction.normalize();
-    line_2_direction.normalize();
-
-    Eigen::Vector4f point;
-    int point_number = 0;
-    for (size_t i = 0; i < indices_->size(); ++i) {
-      pointToEigenVector(input_->points[(*indices_)[i]], point);
-      double squared_distance = std::min(sqrPointToLineDistance(point, corner_point, line_1_direction),
-                                         sqrPointToLineDistance(point, corner_point, line_2_direction));
-
-      if (squared_distance < squared_threshold) {
-        inliers[point_number] = (*indices_)[i];
-        error_sqr_dists_[point_number] = squared_distance;
-        ++point_number;
-      }
-    }
     inliers.resize(point_number);
     error_sqr_dists_.resize(point_number);
+    for (int i = 0; i < point_number; ++i) {
+      inliers[i] = (*indices_)[inliers[i]];
+      error_sqr_dists_[i] = squared_distances_[i];
+    }
   }
 
   int countWithinDistance(const Eigen::VectorXf& model_coefficients, const double threshold) override {
@@ -222,27 +220,9 @@ class SampleConsenusModelCross2D : public SampleConsensusModel<PointT> {
       return 0;
     }
 
-    double squared_threshold = threshold * threshold;
-
-    Eigen::Vector4f corner_point(model_coefficients[0], model_coefficients[1], 0.0, 0.0);
-    Eigen::Vector4f line_1_direction(model_coefficients[2], model_coefficients[3], 0.0, 0.0);
-    Eigen::Vector4f line_2_direction(model_coefficients[3], -model_coefficients[2], 0.0, 0.0);
-    line_1_direction.normalize();
-    line_2_direction.normalize();
-
-    Eigen::Vector4f point;
-    int point_number = 0;
-    for (size_t i = 0; i < indices_->size(); ++i) {
-      pointToEigenVector(input_->points[(*indices_)[i]], point);
-      double squared_distance = std::min(sqrPointToLineDistance(point, corner_point, line_1_direction),
-                                         sqrPointToLineDistance(point, corner_point, line_2_direction));
-
-      if (squared_distance < squared_threshold) {
-        ++point_number;
-      }
-    }
-
-    return point_number;
+    updateCoordinatesIfNeeded();
+    return laser_object_tracker::feature_extraction::countCross2DWithinDistance(
+        kernelCoefficients(model_coefficients), x_.data(), y_.data(), x_.size(), threshold * threshold);
   }
 
   void projectPoints(const std::vector<int>& inliers, const Eigen::VectorXf& model_coefficients,
@@ -396,32 +376,147 @@ class SampleConsenusModelCross2D : public SampleConsensusModel<PointT> {
   }
 
  private:
-  struct OptimizationFunctor : pcl::Functor<float> {
-    OptimizationFunctor(int m_data_points, SampleConsenusModelCross2D<PointT> *model) :
-        Functor(m_data_points),
-        model_(model) {}
-
-    int operator()(const Eigen::VectorXf& x, Eigen::VectorXf& fvec) const {
-      Eigen::Vector4f corner_point(x[0], x[1], 0.0, 0.0);
-      Eigen::Vector4f line_1_direction(x[2], x[3], 0.0, 0.0);
-      Eigen::Vector4f line_2_direction(x[3], -x[2], 0.0, 0.0);
-      line_1_direction.normalize();
-      line_2_direction.normalize();
+  static constexpr int MAX_LM_ITERATIONS = 100;
+  static constexpr float MAX_LM_DAMPING = 1e10f;
+
+  /**
+   * @brief Minimizes sum of squares of inlier residuals, see accumulateNormalEquations().
+   * Jacobian is never stored, only 4x4 normal equations are accumulated, so the state does not depend on the number
+   * of inliers. Damping is scaled by the diagonal of the normal equations, which also regularizes the direction
+   * length, the model does not depend on it.
+   * @return Number of performed iterations
+   */
+  int levenbergMarquardt(Eigen::Vector4f& coefficients, float& residual_norm) const {
+    static constexpr float TOLERANCE = 1e-6f;
+    float cost = evaluateCost(coefficients);
+    float damping = 1e-3f;
+    Eigen::Matrix4f jacobian_product;
+    Eigen::Vector4f gradient;
+
+    int iteration = 0;
+    bool converged = false;
+    for (; iteration < MAX_LM_ITERATIONS && !converged; ++iteration) {
+      accumulateNormalEquations(coefficients, jacobian_product, gradient);
+      Eigen::Vector4f diagonal = jacobian_product.diagonal().cwiseMax(TOLERANCE);
+
+      while (true) {
+        Eigen::Matrix4f damped = jacobian_product;
+        damped.diagonal() += damping * diagonal;
+        Eigen::Vector4f step = damped.ldlt().solve(-gradient);
+        if (step.norm() <= TOLERANCE * (coefficients.norm() + TOLERANCE)) {
+          converged = true;
+          break;
+        }
 
-      Eigen::Vector4f point;
-      for (int i = 0; i < values(); ++i) {
-        model_->pointToEigenVector(model_->input_->points[i], point);
-        double squared_distance = std::min(sqrPointToLineDistance(point, corner_point, line_1_direction),
-                                           sqrPointToLineDistance(point, corner_point, line_2_direction));
+        Eigen::Vector4f candidate = coefficients + step;
+        float candidate_cost = evaluateCost(candidate);
+        if (candidate_cost < cost) {
+          coefficients = candidate;
+          converged = cost - candidate_cost <= TOLERANCE * cost;
+          cost = candidate_cost;
+          damping *= 0.1f;
+          break;
+        }
 
-        fvec[i] = squared_distance;
+        damping *= 10.0f;
+        if (damping > MAX_LM_DAMPING) {
+          converged = true;
+          break;
+        }
       }
+    }
 
-      return 0;
+    residual_norm = std::sqrt(cost);
+    return iteration;
+  }
+
+  float evaluateCost(const Eigen::Vector4f& coefficients) const {
+    Eigen::Vector2f direction = coefficients.tail<2>().normalized();
+    float cost = 0.0f;
+    for (size_t i = 0; i < inlier_x_.size(); ++i) {
+      float qx = inlier_x_[i] - coefficients[0];
+      float qy = inlier_y_[i] - coefficients[1];
+      float a = qx * direction[1] - qy * direction[0];
+      float b = qx * direction[0] + qy * direction[1];
+      float residual = std::min(a * a, b * b);
+      cost += residual * residual;
     }
+    return cost;
+  }
 
-    pcl::SampleConsenusModelCross2D<PointT> *model_;
-  };
+  /**
+   * @brief Accumulates J^T J and J^T r of residuals, which are squared distances of inliers to the closer arm.
+   * Signed distance to the first arm is a = q x u, to the second one b = q . u, where q is the point relative to the
+   * corner and u = d / |d| the normalized direction. Derivatives with respect to d are the ones with respect to u
+   * projected on the normal of u and scaled by 1 / |d|.
+   */
+  void accumulateNormalEquations(const Eigen::Vector4f& coefficients,
+                                 Eigen::Matrix4f& jacobian_product,
+                                 Eigen::Vector4f& gradient) const {
+    float norm = coefficients.tail<2>().norm();
+    Eigen::Vector2f direction = coefficients.tail<2>() / norm;
+    Eigen::Vector2f normal(-direction[1], direction[0]);
+
+    jacobian_product.setZero();
+    gradient.setZero();
+    Eigen::Vector4f jacobian_row;
+    for (size_t i = 0; i < inlier_x_.size(); ++i) {
+      Eigen::Vector2f q(inlier_x_[i] - coefficients[0], inlier_y_[i] - coefficients[1]);
+      float a = q[0] * direction[1] - q[1] * direction[0];
+      float b = q.dot(direction);
+
+      float distance;
+      Eigen::Vector2f direction_gradient;
+      if (a * a <= b * b) {
+        distance = a;
+        jacobian_row.head<2>() = normal;
+        direction_gradient << -q[1], q[0];
+      } else {
+        distance = b;
+        jacobian_row.head<2>() = -direction;
+        direction_gradient = q;
+      }
+      jacobian_row.tail<2>() = direction_gradient.dot(normal) / norm * normal;
+      jacobian_row *= 2.0f * distance;
+
+      jacobian_product.selfadjointView<Eigen::Lower>().rankUpdate(jacobian_row);
+      gradient += distance * distance * jacobian_row;
+    }
+    jacobian_product = jacobian_product.selfadjointView<Eigen::Lower>();
+  }
+
+  /**
+   * @brief Gathers coordinates of indexed points into separate x and y arrays, as expected by the distance kernel.
+   */
+  void updateCoordinates() {
+    x_.resize(indices_->size());
+    y_.resize(indices_->size());
+    for (size_t i = 0; i < indices_->size(); ++i) {
+      x_[i] = input_->points[(*indices_)[i]].x;
+      y_[i] = input_->points[(*indices_)[i]].y;
+    }
+
+    coordinates_input_ = input_.get();
+    coordinates_indices_ = indices_.get();
+  }
+
+  /**
+   * @brief setIndices() is not virtual, so the gathered coordinates are keyed on the cloud and indices they were
+   * gathered from. Points or indices modified in place are not noticed, setInputCloud() needs to be called again.
+   */
+  void updateCoordinatesIfNeeded() {
+    if (coordinates_input_ != input_.get() || coordinates_indices_ != indices_.get() ||
+        x_.size() != indices_->size()) {
+      updateCoordinates();
+    }
+  }
+
+  laser_object_tracker::feature_extraction::Cross2DCoefficients kernelCoefficients(
+      const Eigen::VectorXf& model_coefficients) const {
+    laser_object_tracker::feature_extraction::Cross2DCoefficients coefficients = model_coefficients.head<4>();
+    coefficients.tail<2>().normalize();
+    return coefficients;
+  }
 
   bool vectorsPerpendicular(const Eigen::Vector2d& one, const Eigen::Vector2d& two) const {
     static constexpr float ZERO_TOLERANCE = 0.0001f;
@@ -446,7 +541,14 @@ class SampleConsenusModelCross2D : public SampleConsensusModel<PointT> {
     vector << point.x, point.y, 0.0, 0.0;
   }
 
-  const std::vector<int> *tmp_inliers_;
+  std::vector<float> inlier_x_;
+  std::vector<float> inlier_y_;
+
+  std::vector<float> x_;
+  std::vector<float> y_;
+  const PointCloud* coordinates_input_ = nullptr;
+  const std::vector<int>* coordinates_indices_ = nullptr;
+  std::vector<float> squared_distances_;
 };
 }  // namespace pcl
 
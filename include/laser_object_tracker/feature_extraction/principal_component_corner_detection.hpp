@@ -0,0 +1,75 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_PRINCIPAL_COMPONENT_CORNER_DETECTION_HPP
+#define LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_PRINCIPAL_COMPONENT_CORNER_DETECTION_HPP
+
+#include "laser_object_tracker/feature_extraction/base_feature_extraction.hpp"
+#include "laser_object_tracker/feature_extraction/features/features.hpp"
+#include "laser_object_tracker/feature_extraction/line_moments.hpp"
+
+namespace laser_object_tracker {
+namespace feature_extraction {
+
+/**
+ * @brief Closed-form L-shape fit, linear in the number of points.
+ * Ordered points are split into two arms, so that the sum of total least squares residuals of both arms is minimal,
+ * every split being assessed in constant time from running moments. Corner is an intersection of lines fitted to
+ * the arms. Feature has the same layout as features::Corner2D, e.g. corner followed by ends of both arms.
+ * If arms are closer to parallel than the minimal arm angle, segment is described by its principal axis instead and
+ * the corner is placed at its first end.
+ */
+class PrincipalComponentCornerDetection : public BaseFeatureExtraction {
+ public:
+  explicit PrincipalComponentCornerDetection(double min_arm_angle = M_PI / 8.0);
+
+  bool extractFeature(const data_types::LaserScanFragment& fragment, Eigen::VectorXd& feature) override;
+
+  double getMinArmAngle() const;
+
+  void setMinArmAngle(double min_arm_angle);
+
+  /**
+   * @brief Orientation of the last extracted corner in [0, pi/2), in the convention of
+   * SearchBasedCornerDetection, so it can seed its search.
+   */
+  double getOrientation() const;
+
+ private:
+  double min_arm_angle_;
+  double orientation_ = 0.0;
+};
+}  // namespace feature_extraction
+}  // namespace laser_object_tracker
+
+#endif  // LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_PRINCIPAL_COMPONENT_CORNER_DETECTION_HPP
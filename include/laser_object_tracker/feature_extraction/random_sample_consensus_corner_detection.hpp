@@ -34,10 +34,9 @@
 #ifndef LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_RANDOM_SAMPLE_CONSENSUS_CORNER_DETECTION_HPP
 #define LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_RANDOM_SAMPLE_CONSENSUS_CORNER_DETECTION_HPP
 
-#include <pcl/sample_consensus/ransac.h>
 #include "laser_object_tracker/feature_extraction/base_feature_extraction.hpp"
 #include "laser_object_tracker/feature_extraction/features/features.hpp"
-#include "laser_object_tracker/feature_extraction/pcl/sac_model_cross2d.hpp"
+#include "laser_object_tracker/feature_extraction/sample_consensus_2d.hpp"
 
 namespace laser_object_tracker {
 namespace feature_extraction {
@@ -62,10 +61,12 @@ class RandomSampleConsensusCornerDetection : public BaseFeatureExtraction {
 
   void setProbability(double probability);
 
+  SampleConsensus2D<CrossModel2D>& getSampleConsensus() {
+    return sample_consensus_;
+  }
+
  private:
-  using PointType = data_types::PointCloudType::PointType;
-  using ModelType = pcl::SampleConsenusModelCross2D<PointType>;
-  pcl::RandomSampleConsensus<PointType> sample_consensus_;
+  SampleConsensus2D<CrossModel2D> sample_consensus_;
 };
 }  // namespace feature_extraction
 }  // namespace laser_object_tracker
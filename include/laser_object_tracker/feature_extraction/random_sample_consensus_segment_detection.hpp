@@ -34,11 +34,9 @@
 #ifndef LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_RANDOM_SAMPLE_CONSENSUS_SEGMENT_DETECTION_HPP
 #define LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_RANDOM_SAMPLE_CONSENSUS_SEGMENT_DETECTION_HPP
 
-#include <pcl/sample_consensus/ransac.h>
-#include <pcl/sample_consensus/sac_model_line.h>
-
 #include "laser_object_tracker/feature_extraction/base_feature_extraction.hpp"
 #include "laser_object_tracker/feature_extraction/features/features.hpp"
+#include "laser_object_tracker/feature_extraction/sample_consensus_2d.hpp"
 
 namespace laser_object_tracker {
 namespace feature_extraction {
@@ -63,10 +61,12 @@ class RandomSampleConsensusSegmentDetection : public BaseFeatureExtraction {
 
   void setProbability(double probability);
 
+  SampleConsensus2D<LineModel2D>& getSampleConsensus() {
+    return sample_consensus_;
+  }
+
  private:
-  using PointType = data_types::PointCloudType::PointType;
-  using ModelType = pcl::SampleConsensusModelLine<PointType>;
-  pcl::RandomSampleConsensus<PointType> sample_consensus_;
+  SampleConsensus2D<LineModel2D> sample_consensus_;
 };
 }  // namespace feature_extraction
 }  // namespace laser_object_tracker
@@ -0,0 +1,376 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_SAMPLE_CONSENSUS_2D_HPP
+#define LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_SAMPLE_CONSENSUS_2D_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "laser_object_tracker/feature_extraction/sample_consensus_model_2d.hpp"
+
+namespace laser_object_tracker {
+namespace feature_extraction {
+
+/**
+ * @brief RANSAC over planar points.
+ * Hypotheses are generated in batches and scored block by block against points stored as separate x and y arrays.
+ * Scoring of a hypothesis stops as soon as it cannot beat the best one or the sequential probability ratio test
+ * (SPRT) decides it is a bad one. Batches of large inputs are scored on several threads.
+ * Random generator is seeded deterministically and every batch is scored against the best hypothesis from before the
+ * batch, so the result does not depend on the number of threads.
+ * @tparam Model Type providing SAMPLE_SIZE, Coefficients, computeCoefficients() and countWithinDistance(),
+ * see LineModel2D
+ */
+template<class Model>
+class SampleConsensus2D {
+ public:
+  using Coefficients = typename Model::Coefficients;
+
+  SampleConsensus2D(double distance_threshold, int max_iterations, double probability)
+      : distance_threshold_(distance_threshold),
+        max_iterations_(max_iterations),
+        probability_(probability),
+        threads_number_(std::max(1u, std::thread::hardware_concurrency())) {}
+
+  /**
+   * @brief Finds the model supported by most of the points.
+   * Strided views of a point cloud are accepted as well, points are copied once into the x and y buffers of the
+   * engine. Buffers keep their capacity, so once warm repeated calls allocate only when the input grows.
+   * @param points Points stored in columns
+   * @return False if no valid hypothesis could be generated
+   */
+  bool computeModel(const Eigen::Ref<const Eigen::Matrix2Xf>& points) {
+    x_.resize(points.cols());
+    y_.resize(points.cols());
+    for (long i = 0; i < points.cols(); ++i) {
+      x_[i] = points(0, i);
+      y_[i] = points(1, i);
+    }
+
+    iterations_ = 0;
+    best_inliers_ = -1;
+    inliers_.clear();
+    if (points.cols() < Model::SAMPLE_SIZE) {
+      return false;
+    }
+
+    int required_iterations = max_iterations_;
+    double bad_inlier_ratio = INITIAL_BAD_INLIER_RATIO;
+    while (iterations_ < std::min(required_iterations, max_iterations_)) {
+      int batch_size = std::min(batch_size_, std::min(required_iterations, max_iterations_) - iterations_);
+      if (!generateBatch(batch_size)) {
+        break;
+      }
+      // Generation gives up on a partial batch, if no valid sample can be drawn
+      iterations_ += batch_.size();
+
+      scoreBatch(bad_inlier_ratio);
+
+      double observed_ratio = 0.0;
+      for (const auto& hypothesis : batch_) {
+        observed_ratio += static_cast<double>(hypothesis.inliers_seen) / std::max(1, hypothesis.points_seen);
+        if (hypothesis.inliers > best_inliers_) {
+          best_inliers_ = hypothesis.inliers;
+          coefficients_ = hypothesis.coefficients;
+        }
+      }
+      bad_inlier_ratio = std::min(MAX_BAD_INLIER_RATIO,
+                                  std::max(MIN_BAD_INLIER_RATIO, observed_ratio / std::max<size_t>(1, batch_.size())));
+
+      required_iterations = requiredIterations();
+    }
+
+    if (best_inliers_ < 0) {
+      return false;
+    }
+
+    selectInliers();
+    return true;
+  }
+
+  const Coefficients& getModelCoefficients() const {
+    return coefficients_;
+  }
+
+  /**
+   * @brief Indices of points supporting the model found by the last computeModel() call.
+   */
+  const std::vector<int>& getInliers() const {
+    return inliers_;
+  }
+
+  /**
+   * @brief Number of hypotheses generated by the last computeModel() call.
+   */
+  int getIterations() const {
+    return iterations_;
+  }
+
+  double getDistanceThreshold() const {
+    return distance_threshold_;
+  }
+
+  void setDistanceThreshold(double distance_threshold) {
+    distance_threshold_ = distance_threshold;
+  }
+
+  int getMaxIterations() const {
+    return max_iterations_;
+  }
+
+  void setMaxIterations(int max_iterations) {
+    max_iterations_ = max_iterations;
+  }
+
+  double getProbability() const {
+    return probability_;
+  }
+
+  void setProbability(double probability) {
+    probability_ = probability;
+  }
+
+  int getBatchSize() const {
+    return batch_size_;
+  }
+
+  void setBatchSize(int batch_size) {
+    if (batch_size < 1) {
+      throw std::invalid_argument("Batch size needs to be positive. Batch size: " + std::to_string(batch_size));
+    }
+    batch_size_ = batch_size;
+  }
+
+  int getThreadsNumber() const {
+    return threads_number_;
+  }
+
+  void setThreadsNumber(int threads_number) {
+    if (threads_number < 1) {
+      throw std::invalid_argument("Threads number needs to be positive. Threads number: " +
+          std::to_string(threads_number));
+    }
+    threads_number_ = threads_number;
+  }
+
+  /**
+   * @brief Minimal number of points, for which a batch is scored on several threads.
+   */
+  int getParallelThreshold() const {
+    return parallel_threshold_;
+  }
+
+  void setParallelThreshold(int parallel_threshold) {
+    parallel_threshold_ = parallel_threshold;
+  }
+
+ private:
+  struct Hypothesis {
+    Coefficients coefficients;
+    int inliers = 0;
+    int inliers_seen = 0;
+    int points_seen = 0;
+  };
+
+  /**
+   * @brief Number of points scored between checks for early termination.
+   */
+  static constexpr int BLOCK_SIZE = 64;
+
+  /**
+   * @brief Number of random samples drawn for a single hypothesis before giving up, as in PCL.
+   */
+  static constexpr int MAX_SAMPLE_CHECKS = 1000;
+
+  /**
+   * @brief SPRT rejects a good hypothesis with probability at most 1 / SPRT_DECISION_THRESHOLD.
+   */
+  static constexpr double SPRT_DECISION_THRESHOLD = 100.0;
+
+  static constexpr double INITIAL_BAD_INLIER_RATIO = 0.05;
+  static constexpr double MIN_BAD_INLIER_RATIO = 0.01;
+  static constexpr double MAX_BAD_INLIER_RATIO = 0.99;
+
+  bool generateBatch(int batch_size) {
+    batch_.clear();
+    std::uniform_int_distribution<int> distribution(0, static_cast<int>(x_.size()) - 1);
+    int samples[Model::SAMPLE_SIZE];
+    for (int i = 0; i < batch_size; ++i) {
+      Hypothesis hypothesis;
+      bool valid = false;
+      for (int check = 0; check < MAX_SAMPLE_CHECKS && !valid; ++check) {
+        for (int sample = 0; sample < Model::SAMPLE_SIZE; ++sample) {
+          do {
+            samples[sample] = distribution(random_engine_);
+          } while (std::find(samples, samples + sample, samples[sample]) != samples + sample);
+        }
+        valid = Model::computeCoefficients(x_.data(), y_.data(), samples, hypothesis.coefficients);
+      }
+
+      if (!valid) {
+        return !batch_.empty();
+      }
+      batch_.push_back(hypothesis);
+    }
+
+    return true;
+  }
+
+  void scoreBatch(double bad_inlier_ratio) {
+    // SPRT is only meaningful once good hypotheses are expected to have more inliers than bad ones
+    double good_inlier_ratio = static_cast<double>(best_inliers_) / x_.size();
+    bool sprt = good_inlier_ratio > bad_inlier_ratio && good_inlier_ratio < 1.0;
+    double log_inlier_ratio = sprt ? std::log(bad_inlier_ratio / good_inlier_ratio) : 0.0;
+    double log_outlier_ratio = sprt ? std::log((1.0 - bad_inlier_ratio) / (1.0 - good_inlier_ratio)) : 0.0;
+
+    auto score_range = [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        scoreHypothesis(batch_[i], sprt, log_inlier_ratio, log_outlier_ratio);
+      }
+    };
+
+    int threads_number = static_cast<int>(x_.size()) >= parallel_threshold_ ?
+                         std::min<int>(threads_number_, batch_.size()) : 1;
+    if (threads_number <= 1) {
+      score_range(0, batch_.size());
+      return;
+    }
+
+    futures_.clear();
+    size_t chunk = (batch_.size() + threads_number - 1) / threads_number;
+    for (size_t begin = chunk; begin < batch_.size(); begin += chunk) {
+      futures_.push_back(std::async(std::launch::async, score_range, begin, std::min(batch_.size(), begin + chunk)));
+    }
+    score_range(0, std::min(batch_.size(), chunk));
+    for (auto& future : futures_) {
+      future.get();
+    }
+  }
+
+  /**
+   * @brief Counts inliers of the hypothesis, which is set to -1 if it was terminated early.
+   */
+  void scoreHypothesis(Hypothesis& hypothesis, bool sprt, double log_inlier_ratio, double log_outlier_ratio) const {
+    const int points_number = x_.size();
+    const float squared_threshold = distance_threshold_ * distance_threshold_;
+    double log_likelihood_ratio = 0.0;
+    const double log_decision_threshold = std::log(SPRT_DECISION_THRESHOLD);
+
+    hypothesis.inliers = -1;
+    hypothesis.inliers_seen = 0;
+    hypothesis.points_seen = 0;
+    for (int begin = 0; begin < points_number; begin += BLOCK_SIZE) {
+      int count = std::min(BLOCK_SIZE, points_number - begin);
+      int block_inliers = Model::countWithinDistance(hypothesis.coefficients, x_.data() + begin, y_.data() + begin,
+                                                     count, squared_threshold);
+      hypothesis.inliers_seen += block_inliers;
+      hypothesis.points_seen += count;
+
+      // Even if every remaining point was an inlier, the best hypothesis would not be beaten
+      if (hypothesis.inliers_seen + points_number - hypothesis.points_seen <= best_inliers_) {
+        return;
+      }
+
+      if (sprt) {
+        log_likelihood_ratio += block_inliers * log_inlier_ratio + (count - block_inliers) * log_outlier_ratio;
+        if (log_likelihood_ratio > log_decision_threshold) {
+          return;
+        }
+      }
+    }
+
+    hypothesis.inliers = hypothesis.inliers_seen;
+  }
+
+  int requiredIterations() const {
+    double inlier_ratio = static_cast<double>(best_inliers_) / x_.size();
+    double no_outliers_probability = 1.0 - std::pow(inlier_ratio, Model::SAMPLE_SIZE);
+    if (no_outliers_probability <= 0.0) {
+      return 0;
+    }
+    if (no_outliers_probability >= 1.0) {
+      return max_iterations_;
+    }
+
+    double iterations = std::log(1.0 - probability_) / std::log(no_outliers_probability);
+    return iterations < max_iterations_ ? static_cast<int>(std::ceil(iterations)) : max_iterations_;
+  }
+
+  void selectInliers() {
+    const float squared_threshold = distance_threshold_ * distance_threshold_;
+    for (int i = 0; i < static_cast<int>(x_.size()); ++i) {
+      if (Model::countWithinDistance(coefficients_, &x_[i], &y_[i], 1, squared_threshold) > 0) {
+        inliers_.push_back(i);
+      }
+    }
+  }
+
+  double distance_threshold_;
+  int max_iterations_;
+  double probability_;
+  int batch_size_ = 32;
+  int threads_number_;
+  int parallel_threshold_ = 2048;
+
+  std::mt19937 random_engine_;
+  std::vector<float> x_;
+  std::vector<float> y_;
+  std::vector<Hypothesis> batch_;
+  std::vector<std::future<void>> futures_;
+
+  int iterations_ = 0;
+  int best_inliers_ = -1;
+  Coefficients coefficients_ = Coefficients::Zero();
+  std::vector<int> inliers_;
+};
+
+template<class Model> constexpr int SampleConsensus2D<Model>::BLOCK_SIZE;
+template<class Model> constexpr int SampleConsensus2D<Model>::MAX_SAMPLE_CHECKS;
+template<class Model> constexpr double SampleConsensus2D<Model>::SPRT_DECISION_THRESHOLD;
+template<class Model> constexpr double SampleConsensus2D<Model>::INITIAL_BAD_INLIER_RATIO;
+template<class Model> constexpr double SampleConsensus2D<Model>::MIN_BAD_INLIER_RATIO;
+template<class Model> constexpr double SampleConsensus2D<Model>::MAX_BAD_INLIER_RATIO;
+}  // namespace feature_extraction
+}  // namespace laser_object_tracker
+
+#endif  // LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_SAMPLE_CONSENSUS_2D_HPP
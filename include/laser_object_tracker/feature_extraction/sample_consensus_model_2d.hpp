@@ -0,0 +1,153 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_SAMPLE_CONSENSUS_MODEL_2D_HPP
+#define LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_SAMPLE_CONSENSUS_MODEL_2D_HPP
+
+#include <cmath>
+
+#include <Eigen/Core>
+
+#include "laser_object_tracker/feature_extraction/cross2d_distance_kernel.hpp"
+
+namespace laser_object_tracker {
+namespace feature_extraction {
+
+/**
+ * @brief Line in a plane, coefficients are a point on the line and unit direction (x, y, dx, dy).
+ */
+struct LineModel2D {
+  static constexpr int SAMPLE_SIZE = 2;
+
+  // Unaligned, so that hypotheses can be stored in standard containers and in members of any class
+  using Coefficients = Eigen::Matrix<float, 4, 1, Eigen::DontAlign>;
+
+  static bool computeCoefficients(const float* x, const float* y, const int* samples, Coefficients& coefficients) {
+    Eigen::Vector2f point(x[samples[0]], y[samples[0]]);
+    Eigen::Vector2f direction = Eigen::Vector2f(x[samples[1]], y[samples[1]]) - point;
+    float norm = direction.norm();
+    if (norm < ZERO_TOLERANCE) {
+      return false;
+    }
+
+    coefficients << point, direction / norm;
+    return true;
+  }
+
+  /**
+   * @brief Counts points with squared distance to the line below squared_threshold.
+   * Points are passed as separate x and y arrays, so the expression is evaluated several points at a time.
+   */
+  static int countWithinDistance(const Coefficients& coefficients, const float* x, const float* y, int count,
+                                 float squared_threshold) {
+    Eigen::Map<const Eigen::ArrayXf> xs(x, count), ys(y, count);
+    return (((xs - coefficients(0)) * -coefficients(3) +
+        (ys - coefficients(1)) * coefficients(2)).square() < squared_threshold).count();
+  }
+
+  static constexpr float ZERO_TOLERANCE = 1e-6f;
+};
+
+/**
+ * @brief Two perpendicular lines crossing at a corner, coefficients are the corner and unit direction of the first
+ * line (x, y, dx, dy), the second line is directed along (dy, -dx).
+ * Same model as pcl::SampleConsenusModelCross2D, a sample is accepted only if two of its points span a right angle.
+ */
+struct CrossModel2D {
+  static constexpr int SAMPLE_SIZE = 3;
+
+  using Coefficients = Cross2DCoefficients;
+
+  static bool computeCoefficients(const float* x, const float* y, const int* samples, Coefficients& coefficients) {
+    Eigen::Vector2d p0(x[samples[0]], y[samples[0]]);
+    Eigen::Vector2d p1(x[samples[1]], y[samples[1]]);
+    Eigen::Vector2d p2(x[samples[2]], y[samples[2]]);
+
+    if (p0.isApprox(p1) && p0.isApprox(p2)) {
+      return false;
+    }
+
+    Eigen::Vector2d d0 = p1 - p0;
+    Eigen::Vector2d d1 = p2 - p1;
+    Eigen::Vector2d d2 = p2 - p0;
+
+    Eigen::Vector2d corner;
+    Eigen::Vector2d point;
+    if (vectorsPerpendicular(d0, d1)) {
+      corner = p1;
+      point = firstCounterClockwise(p0, p2, p1);
+    } else if (vectorsPerpendicular(d0, d2)) {
+      corner = p0;
+      point = firstCounterClockwise(p1, p2, p0);
+    } else if (vectorsPerpendicular(d1, d2)) {
+      corner = p2;
+      point = firstCounterClockwise(p0, p1, p2);
+    } else {
+      return false;
+    }
+
+    Eigen::Vector2d direction = point - corner;
+    if (direction.isZero()) {
+      return false;
+    }
+
+    coefficients << corner.cast<float>(), direction.normalized().cast<float>();
+    return true;
+  }
+
+  /**
+   * @brief Counts points with squared distance to the closer of both lines below squared_threshold.
+   * Vectorized with AVX2 when the CPU supports it, see countCross2DWithinDistance().
+   */
+  static int countWithinDistance(const Coefficients& coefficients, const float* x, const float* y, int count,
+                                 float squared_threshold) {
+    return countCross2DWithinDistance(coefficients, x, y, count, squared_threshold);
+  }
+
+ private:
+  static bool vectorsPerpendicular(const Eigen::Vector2d& one, const Eigen::Vector2d& two) {
+    static constexpr double ZERO_TOLERANCE = 0.0001;
+    return std::fabs(one.dot(two)) < ZERO_TOLERANCE;
+  }
+
+  static Eigen::Vector2d firstCounterClockwise(const Eigen::Vector2d& one, const Eigen::Vector2d& two,
+                                               const Eigen::Vector2d& relative) {
+    Eigen::Vector2d first_vec = one - relative;
+    Eigen::Vector2d second_vec = two - relative;
+    return std::atan2(first_vec[1], first_vec[0]) < std::atan2(second_vec[1], second_vec[0]) ? one : two;
+  }
+};
+}  // namespace feature_extraction
+}  // namespace laser_object_tracker
+
+#endif  // LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_SAMPLE_CONSENSUS_MODEL_2D_HPP
@@ -34,6 +34,8 @@
 #ifndef LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_SEARCH_BASED_CORNER_DETECTION_HPP
 #define LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_SEARCH_BASED_CORNER_DETECTION_HPP
 
+#include <limits>
+
 #include "laser_object_tracker/feature_extraction/base_feature_extraction.hpp"
 #include "laser_object_tracker/feature_extraction/features/features.hpp"
 
@@ -48,6 +50,41 @@ class SearchBasedCornerDetection : public BaseFeatureExtraction {
 
   bool extractFeature(const data_types::LaserScanFragment& fragment, Eigen::VectorXd& feature) override;
 
+  /**
+   * @brief Searches only within hint window around the orientation hint, e.g. orientation of a tracked object in the
+   * previous scan. Falls back to the full sweep if the best orientation lies on the border of the window, since
+   * the optimum is then likely outside of it, or if its assessment is below min hint assessment, since the window
+   * then holds only a poor local optimum.
+   */
+  bool extractFeature(const data_types::LaserScanFragment& fragment, Eigen::VectorXd& feature,
+                      double orientation_hint);
+
+  /**
+   * @brief Orientation of the last extracted corner in [0, pi/2).
+   */
+  double getOrientation() const;
+
+  /**
+   * @brief Criterion assessment of the orientation of the last extracted corner.
+   */
+  double getAssessment() const;
+
+  double getHintWindow() const;
+
+  /**
+   * @brief Half-width of the orientation window searched around the hint. Default of 0.07 evaluates about 11 times
+   * fewer orientations than the full sweep over pi/2.
+   */
+  void setHintWindow(double hint_window);
+
+  double getMinHintAssessment() const;
+
+  /**
+   * @brief Assessment, in units of the criterion, below which the hinted search falls back to the full sweep.
+   * Default of minus infinity never falls back because of the assessment.
+   */
+  void setMinHintAssessment(double min_hint_assessment);
+
   double getThetaResolution() const;
 
   void setThetaResolution(double theta_resolution);
@@ -57,6 +94,15 @@ class SearchBasedCornerDetection : public BaseFeatureExtraction {
   void setCriterion(const CriterionFunctor& criterion);
 
  private:
+  /**
+   * @brief Finds orientation with the best assessment in [from, to).
+   * @return False if the best orientation is the first or the last one assessed
+   */
+  bool searchOrientation(const Eigen::MatrixX2d& points, double from, double to,
+                         double& best_angle, double& best_assessment) const;
+
+  void buildFeature(const Eigen::MatrixX2d& points, double angle, Eigen::VectorXd& feature);
+
   Eigen::VectorXd findMatchingCorner(const Eigen::VectorXd& x, const Eigen::VectorXd& y,
                                      const Eigen::Hyperplane<double, 2>& one,
                                      const Eigen::Hyperplane<double, 2>& two,
@@ -74,6 +120,10 @@ class SearchBasedCornerDetection : public BaseFeatureExtraction {
 
   double theta_resolution_;
   CriterionFunctor criterion_;
+  double hint_window_ = 0.07;
+  double min_hint_assessment_ = -std::numeric_limits<double>::infinity();
+  double orientation_ = 0.0;
+  double assessment_ = 0.0;
 };
 
 double areaCriterion(const Eigen::VectorXd& x, const Eigen::VectorXd& y);
@@ -0,0 +1,78 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_SEGMENT_DECIMATION_HPP
+#define LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_SEGMENT_DECIMATION_HPP
+
+#include <Eigen/Core>
+
+#include "laser_object_tracker/data_types/laser_scan_fragment.hpp"
+
+namespace laser_object_tracker {
+namespace feature_extraction {
+
+/**
+ * @brief Thins points of a segment to a spacing, which grows with range, so that the cost of feature extraction is
+ * bounded per object rather than per beam. Point is kept, once the length of the polyline from the last kept point
+ * reaches max(min spacing, angular spacing * range). Both ends, extremes along x and y axes and the point farthest
+ * from the line through the ends, e.g. a corner candidate, are always kept.
+ */
+class SegmentDecimation {
+ public:
+  SegmentDecimation(double min_spacing, double angular_spacing);
+
+  /**
+   * @brief Copies kept points of the fragment to the first columns of decimated points, in their order.
+   * Buffer grows only if it has fewer columns than the fragment has points, so it can be reused between segments.
+   * @return Number of kept points
+   */
+  long decimate(const data_types::LaserScanFragment& fragment, Eigen::Matrix2Xf& decimated_points) const;
+
+  double getTargetSpacing(double range) const;
+
+  double getMinSpacing() const;
+
+  void setMinSpacing(double min_spacing);
+
+  double getAngularSpacing() const;
+
+  void setAngularSpacing(double angular_spacing);
+
+ private:
+  double min_spacing_;
+  double angular_spacing_;
+};
+}  // namespace feature_extraction
+}  // namespace laser_object_tracker
+
+#endif  // LASER_OBJECT_TRACKER_FEATURE_EXTRACTION_SEGMENT_DECIMATION_HPP
@@ -34,21 +34,104 @@
 #ifndef LASER_OBJECT_TRACKER_FILTERING_AGGREGATE_SEGMENTED_FILTERING_HPP
 #define LASER_OBJECT_TRACKER_FILTERING_AGGREGATE_SEGMENTED_FILTERING_HPP
 
+#include <chrono>
+
 #include "laser_object_tracker/filtering/base_segmented_filtering.hpp"
 
 namespace laser_object_tracker {
 namespace filtering {
 
+/**
+ * @brief Runtime statistics of a single filter inside AggregateSegmentedFiltering. Filters are evaluated lazily, so
+ * calls and rejections only count fragments which were not rejected by any filter run before. Only sampled calls are
+ * timed and all values decay on reordering, so they are not integral.
+ */
+struct FilterStatistics {
+  double calls = 0.0;
+  double rejections = 0.0;
+  double timed_calls = 0.0;
+  std::chrono::duration<double> total_time{0.0};
+
+  /**
+   * @return Mean time of a single timed shouldFilter call, in seconds
+   */
+  double averageCost() const;
+
+  /**
+   * @return Fraction of calls which rejected the fragment
+   */
+  double rejectionRate() const;
+
+  /**
+   * @brief Scales all values, so that older calls weigh less than the recent ones
+   */
+  void decay(double factor);
+};
+
+/**
+ * @brief Rejects fragment if any of the aggregated filters does. Calls of the aggregated filters are timed every
+ * timing period and the evaluation order is periodically updated, so filters which are cheap and reject often run first.
+ */
 class AggregateSegmentedFiltering : public BaseSegmentedFiltering {
  public:
-  AggregateSegmentedFiltering(std::vector<std::unique_ptr<BaseSegmentedFiltering>>&& filters);
+  /**
+   * @param filters Filters, evaluated in the given order until the first reordering
+   * @param reorder_period Number of shouldFilter calls between reorderings, 0 keeps the given order
+   */
+  AggregateSegmentedFiltering(std::vector<std::unique_ptr<BaseSegmentedFiltering>>&& filters,
+                              long reorder_period = 1000);
 
   bool shouldFilter(const data_types::LaserScanFragment& fragment) const override;
 
   void add(std::unique_ptr<BaseSegmentedFiltering> filter);
 
+  /**
+   * @return Statistics of the filters, in the order they were added
+   */
+  const std::vector<FilterStatistics>& getStatistics() const;
+
+  void resetStatistics();
+
+  /**
+   * @return Indices of filters, in the order they were added, sorted in the current evaluation order
+   */
+  const std::vector<size_t>& getEvaluationOrder() const;
+
+  long getReorderPeriod() const;
+
+  void setReorderPeriod(long reorder_period);
+
+  long getTimingPeriod() const;
+
+  /**
+   * @param timing_period Filters are timed on every timing_period-th shouldFilter call, 1 times all of them
+   */
+  void setTimingPeriod(long timing_period);
+
+  double getStatisticsDecay() const;
+
+  /**
+   * @param statistics_decay Factor scaling statistics after every reordering, 1 keeps the whole history
+   */
+  void setStatisticsDecay(double statistics_decay);
+
  private:
+  /**
+   * @brief Sorts filters by expected cost of rejecting a fragment, that is mean cost divided by rejection rate.
+   * Filters which have never rejected anything go last, keeping their relative order.
+   */
+  void reorder() const;
+
   std::vector<std::unique_ptr<BaseSegmentedFiltering>> filters_;
+  long reorder_period_;
+  long timing_period_ = 16;
+  double statistics_decay_ = 0.5;
+
+  // Updated from the const shouldFilter, as required by the BaseSegmentedFiltering interface
+  mutable std::vector<FilterStatistics> statistics_;
+  mutable std::vector<size_t> order_;
+  mutable long calls_since_reorder_ = 0;
+  mutable long calls_since_timing_ = 0;
 };
 
 }  // namespace filtering
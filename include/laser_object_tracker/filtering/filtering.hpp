@@ -37,6 +37,9 @@
 #include "laser_object_tracker/filtering/aggregate_segmented_filtering.hpp"
 #include "laser_object_tracker/filtering/base_segmented_filtering.hpp"
 #include "laser_object_tracker/filtering/obb_area_filter.hpp"
+#include "laser_object_tracker/filtering/occlusion_detection.hpp"
 #include "laser_object_tracker/filtering/points_number_filter.hpp"
+#include "laser_object_tracker/filtering/segment_merging.hpp"
+#include "laser_object_tracker/filtering/static_filter_cascade.hpp"
 
 #endif  // LASER_OBJECT_TRACKER_FILTERING_FILTERING_HPP
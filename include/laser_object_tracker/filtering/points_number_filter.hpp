@@ -43,7 +43,10 @@ class PointsNumberFilter : public BaseSegmentedFiltering {
  public:
   PointsNumberFilter(int min_points, int max_points);
 
-  bool shouldFilter(const data_types::LaserScanFragment& fragment) const override;
+  // Defined inline, so StaticFilterCascade can fuse it into its loop
+  bool shouldFilter(const data_types::LaserScanFragment& fragment) const override {
+    return fragment.size() < min_points_ || fragment.size() > max_points_;
+  }
 
   int getMinPoints() const;
 
@@ -0,0 +1,98 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_FILTERING_SEGMENT_MERGING_HPP
+#define LASER_OBJECT_TRACKER_FILTERING_SEGMENT_MERGING_HPP
+
+#include <vector>
+
+#include "laser_object_tracker/filtering/base_segmented_filtering.hpp"
+
+namespace laser_object_tracker {
+namespace filtering {
+
+/**
+ * @brief Merges segments of a single object split by breakpoint detection, e.g. legs of a person or an object partially
+ * occluded by a closer one. Segments need to be ordered by bearing, as produced by segmentation, with occlusion flags
+ * set by OcclusionDetection.
+ * Pairs of segments are joined in a union-find structure, if the gap between the last point of the former and the
+ * first point of the latter is small enough. Segments separated by others are considered only if the segments in
+ * between occlude the gap, that is OcclusionDetection flagged their ends bordering the gap as the closer ones and every
+ * segment in between is closer than both ends of the gap. Merged segments list points of their members in scan order.
+ * Beams of occluding segments are not stored, so elements of such segments keep their angles explicitly.
+ */
+class SegmentMerging : public BaseSegmentedFiltering {
+ public:
+  /**
+   * @param max_gap_distance Maximal distance between end points of merged segments
+   * @param max_skipped_segments Maximal number of occluding segments between merged segments, 0 merges only neighbours
+   */
+  explicit SegmentMerging(double max_gap_distance, int max_skipped_segments = 1);
+
+  bool shouldFilter(const data_types::LaserScanFragment& fragment) const override;
+
+  void filter(std::vector<data_types::LaserScanFragment>& fragments) const override;
+
+  /**
+   * @return True if the fragments should be merged, former preceding the latter with skipped fragments in between
+   */
+  bool shouldMerge(const std::vector<data_types::LaserScanFragment>& fragments, int former, int latter) const;
+
+  double getMaxGapDistance() const;
+
+  void setMaxGapDistance(double max_gap_distance);
+
+  int getMaxSkippedSegments() const;
+
+  void setMaxSkippedSegments(int max_skipped_segments);
+
+ private:
+  int find(int index) const;
+
+  void unite(int lhs, int rhs) const;
+
+  double max_gap_distance_;
+  int max_skipped_segments_;
+
+  // Scratch buffers of the const filter, as required by the BaseSegmentedFiltering interface
+  mutable std::vector<int> parents_;
+  mutable std::vector<int> first_members_;
+  mutable std::vector<std::vector<int>> groups_;
+  mutable std::vector<const data_types::LaserScanFragment*> members_;
+  mutable std::vector<data_types::LaserScanFragment> merged_;
+};
+
+}  // namespace filtering
+}  // namespace laser_object_tracker
+
+#endif //LASER_OBJECT_TRACKER_FILTERING_SEGMENT_MERGING_HPP
@@ -0,0 +1,107 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_FILTERING_STATIC_FILTER_CASCADE_HPP
+#define LASER_OBJECT_TRACKER_FILTERING_STATIC_FILTER_CASCADE_HPP
+
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+
+#include "laser_object_tracker/filtering/base_segmented_filtering.hpp"
+
+namespace laser_object_tracker {
+namespace filtering {
+
+/**
+ * @brief Rejects fragment if any of the Filters does, evaluating them in the order of template arguments.
+ * Unlike AggregateSegmentedFiltering, the set of filters is fixed at compile time and every predicate is called
+ * without virtual dispatch, so the whole cascade is fused into a single loop over the fragments.
+ * @tparam Filters Concrete BaseSegmentedFiltering types, stored by value
+ */
+template<class... Filters>
+class StaticFilterCascade : public BaseSegmentedFiltering {
+ public:
+  explicit StaticFilterCascade(Filters... filters) : filters_(std::move(filters)...) {}
+
+  bool shouldFilter(const data_types::LaserScanFragment& fragment) const override {
+    return shouldFilterFrom<0>(fragment);
+  }
+
+  void filter(std::vector<data_types::LaserScanFragment>& fragments) const override {
+    fragments.erase(std::remove_if(fragments.begin(),
+                                   fragments.end(),
+                                   [this](const data_types::LaserScanFragment& fragment) {
+                                     return shouldFilterFrom<0>(fragment);
+                                   }),
+                    fragments.end());
+  }
+
+  /**
+   * @return Filter at the given position of the cascade, e.g. to adjust its parameters
+   */
+  template<size_t Index>
+  std::tuple_element_t<Index, std::tuple<Filters...>>& get() {
+    return std::get<Index>(filters_);
+  }
+
+  template<size_t Index>
+  const std::tuple_element_t<Index, std::tuple<Filters...>>& get() const {
+    return std::get<Index>(filters_);
+  }
+
+ private:
+  template<size_t Index>
+  std::enable_if_t<(Index < sizeof...(Filters)), bool>
+  shouldFilterFrom(const data_types::LaserScanFragment& fragment) const {
+    using Filter = std::tuple_element_t<Index, std::tuple<Filters...>>;
+    static_assert(std::is_base_of<BaseSegmentedFiltering, Filter>::value,
+                  "StaticFilterCascade accepts only BaseSegmentedFiltering implementations");
+
+    // Qualified call is bound statically, even though shouldFilter is virtual
+    return std::get<Index>(filters_).Filter::shouldFilter(fragment) || shouldFilterFrom<Index + 1>(fragment);
+  }
+
+  template<size_t Index>
+  std::enable_if_t<(Index == sizeof...(Filters)), bool>
+  shouldFilterFrom(const data_types::LaserScanFragment& fragment) const {
+    return false;
+  }
+
+  std::tuple<Filters...> filters_;
+};
+
+}  // namespace filtering
+}  // namespace laser_object_tracker
+
+#endif //LASER_OBJECT_TRACKER_FILTERING_STATIC_FILTER_CASCADE_HPP
@@ -0,0 +1,103 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_PIPELINE_CONTEXT_HPP
+#define LASER_OBJECT_TRACKER_PIPELINE_CONTEXT_HPP
+
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "laser_object_tracker/data_types/frame_arena.hpp"
+#include "laser_object_tracker/data_types/laser_scan_fragment.hpp"
+#include "laser_object_tracker/feature_extraction/features/features.hpp"
+
+namespace laser_object_tracker {
+
+/**
+ * @brief Buffers of every pipeline stage, owned by the node and passed down by reference.
+ * Buffers are cleared instead of recreated between frames, so once their capacity settles a frame does not
+ * reallocate them.
+ */
+struct PipelineContext {
+  /**
+   * @brief Prepares buffers for the next frame, capacity of every buffer is kept.
+   */
+  void clear() {
+    segments.clear();
+    features.clear();
+    // Orientations of the previous frame are kept as hints for the corner search of nearby segments
+    std::swap(centroids, previous_centroids);
+    std::swap(orientations, previous_orientations);
+    corners_2_d.clear();
+    centroids.clear();
+    orientations.clear();
+    frame_arena.reset();
+  }
+
+  /**
+   * @brief Reserves capacity for the expected number of segments per frame.
+   */
+  void reserve(int segments_number) {
+    segments.reserve(segments_number);
+    features.reserve(segments_number);
+    corners_2_d.reserve(segments_number);
+    centroids.reserve(segments_number);
+    orientations.reserve(segments_number);
+    previous_centroids.reserve(segments_number);
+    previous_orientations.reserve(segments_number);
+  }
+
+  std::vector<data_types::LaserScanFragment> segments;
+  Eigen::VectorXd feature;
+  std::vector<Eigen::VectorXd> features;
+  feature_extraction::features::Corners2D corners_2_d;
+  /** @brief Centroid of the segment of every extracted corner */
+  std::vector<data_types::DescriptorVector> centroids;
+  /** @brief Orientation of every extracted corner, see SearchBasedCornerDetection::getOrientation */
+  std::vector<double> orientations;
+
+  std::vector<data_types::DescriptorVector> previous_centroids;
+  std::vector<double> previous_orientations;
+
+  /**
+   * @brief Scratch memory of the association stage, see MultiTracker::setFrameArena.
+   * Only the cost matrix and the assignment scratch live in the arena, buffers of the other stages hold ROS, PCL and
+   * Eigen containers with their own allocators and are reused between frames instead.
+   */
+  data_types::FrameArena frame_arena;
+};
+}  // namespace laser_object_tracker
+
+#endif  // LASER_OBJECT_TRACKER_PIPELINE_CONTEXT_HPP
@@ -35,6 +35,7 @@
 #define LASER_OBJECT_TRACKER_SEGMENTATION_ADAPTIVE_BREAKPOINT_DETECTION_HPP
 
 #include "laser_object_tracker/segmentation/base_segmentation.hpp"
+#include "laser_object_tracker/segmentation/chunked_segmentation.hpp"
 
 namespace laser_object_tracker {
 namespace segmentation {
@@ -45,6 +46,44 @@ class AdaptiveBreakpointDetection : public BaseSegmentation {
 
   std::vector<data_types::LaserScanFragment> segment(const data_types::LaserScanFragment& fragment) override;
 
+  void segment(const data_types::LaserScanFragment& fragment,
+               std::vector<data_types::LaserScanFragment>& segments) override;
+
+  /**
+   * @brief Enables segmentation of up to chunks number angular chunks of the scan on separate threads.
+   * Segments are identical to those of a single chunk.
+   */
+  void setChunksNumber(int chunks_number) {
+    chunked_segmentation_.setChunksNumber(chunks_number);
+  }
+
+  int getChunksNumber() const {
+    return chunked_segmentation_.getChunksNumber();
+  }
+
+  /**
+   * @brief Enables merging of the first and the last segment of full revolution scans, if they are contiguous across
+   * the seam.
+   */
+  void setWrapAround(bool wrap_around) {
+    chunked_segmentation_.setWrapAround(wrap_around);
+  }
+
+  bool getWrapAround() const {
+    return chunked_segmentation_.getWrapAround();
+  }
+
+  /**
+   * @brief Flags ends of segments as OcclusionDetection does, within the segmentation pass. Negative gap disables it.
+   */
+  void setOcclusionAngleGap(double occlusion_angle_gap) {
+    chunked_segmentation_.setOcclusionAngleGap(occlusion_angle_gap);
+  }
+
+  double getOcclusionAngleGap() const {
+    return chunked_segmentation_.getOcclusionAngleGap();
+  }
+
   double getIncidenceAngle() const;
 
   void setIncidenceAngle(double incidence_angle);
@@ -59,6 +98,8 @@ class AdaptiveBreakpointDetection : public BaseSegmentation {
 
   double distance_resolution_;
   double incidence_angle_;
+
+  ChunkedSegmentation chunked_segmentation_;
 };
 }  // namespace segmentation
 }  // namespace laser_object_tracker
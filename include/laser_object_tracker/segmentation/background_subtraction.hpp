@@ -0,0 +1,153 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_SEGMENTATION_BACKGROUND_SUBTRACTION_HPP
+#define LASER_OBJECT_TRACKER_SEGMENTATION_BACKGROUND_SUBTRACTION_HPP
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "laser_object_tracker/data_types/definitions.hpp"
+
+namespace laser_object_tracker {
+namespace segmentation {
+
+/**
+ * @brief Per-beam background model, which removes static structure from the scan before segmentation.
+ * Every beam keeps a ring buffer with history size past ranges, a new range is recorded every update period scans.
+ * Beam is background, if at least min matches of recorded ranges are within distance tolerance from its current
+ * range. Background beams are set to +inf, e.g. no return, so they become invalid elements of the fragment and are
+ * skipped by segmentation, while indices of all beams are kept.
+ */
+class BackgroundSubtraction {
+ public:
+  BackgroundSubtraction(int history_size, int min_matches, double distance_tolerance, int update_period);
+
+  BackgroundSubtraction(const BackgroundSubtraction&) = delete;
+
+  BackgroundSubtraction& operator=(const BackgroundSubtraction&) = delete;
+
+  /**
+   * @brief Finishes the snapshot requested by saveAsync(), if any, and stops the writer thread.
+   */
+  ~BackgroundSubtraction();
+
+  /**
+   * @brief Classifies beams of the scan against the model, masks background ones and updates the model.
+   * Model is reset, if the frame or geometry of the scan differs from the modelled one.
+   * @return Number of valid beams left as foreground
+   */
+  long apply(data_types::LaserScanType& laser_scan);
+
+  /**
+   * @brief Forgets all recorded ranges and sets the number of modelled beams.
+   */
+  void reset(long beams_number);
+
+  /**
+   * @brief Writes recorded ranges with frame and geometry of the modelled scanner to a binary file.
+   * File is written next to the path and renamed, so a concurrent reader never sees a partial snapshot.
+   * @return False if the file could not be written
+   */
+  bool save(const std::string& path) const;
+
+  /**
+   * @brief Copies recorded ranges and writes them as save() does, but on a writer thread owned by the model.
+   * Only the copy is made by the caller, its buffer and the thread are reused between calls.
+   * @return False if the previous snapshot could not be written or is still being written, in the latter case this
+   * snapshot is skipped
+   */
+  bool saveAsync(const std::string& path);
+
+  /**
+   * @brief Blocks until the snapshot requested by saveAsync() is written.
+   * @return False if it could not be written
+   */
+  bool waitForSnapshot();
+
+  /**
+   * @brief Restores a snapshot written by save(), by mapping the file into memory.
+   * The model is used only for scans of the same frame and geometry, otherwise it is reset by the first apply().
+   * @return False if the file does not exist, is corrupted or was written with a different history size
+   */
+  bool load(const std::string& path);
+
+  int getHistorySize() const;
+
+  int getMinMatches() const;
+
+  void setMinMatches(int min_matches);
+
+  double getDistanceTolerance() const;
+
+  void setDistanceTolerance(double distance_tolerance);
+
+  int getUpdatePeriod() const;
+
+ private:
+  int history_size_;
+  int min_matches_;
+  float distance_tolerance_;
+  int update_period_;
+
+  std::string frame_id_;
+  float angle_min_ = 0.0f;
+  float angle_increment_ = 0.0f;
+
+  /** @brief Recorded ranges, history size consecutive values per beam */
+  std::vector<float> history_;
+  long beams_number_ = 0;
+  int slot_ = 0;
+  long scans_number_ = 0;
+
+  void serialize(std::vector<char>& snapshot) const;
+
+  void writeSnapshots();
+
+  /** @brief Snapshot handed over to the writer thread, guarded by snapshot_mutex_ while pending */
+  std::vector<char> snapshot_;
+  std::string snapshot_path_;
+  bool snapshot_pending_ = false;
+  bool snapshot_written_ = true;
+  bool stopping_ = false;
+  std::mutex snapshot_mutex_;
+  std::condition_variable snapshot_condition_;
+  std::thread writer_;
+};
+}  // namespace segmentation
+}  // namespace laser_object_tracker
+
+#endif  // LASER_OBJECT_TRACKER_SEGMENTATION_BACKGROUND_SUBTRACTION_HPP
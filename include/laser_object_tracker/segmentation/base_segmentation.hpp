@@ -34,6 +34,7 @@
 #ifndef LASER_OBJECT_TRACKER_SEGMENTATION_BASE_SEGMENTATION_HPP
 #define LASER_OBJECT_TRACKER_SEGMENTATION_BASE_SEGMENTATION_HPP
 
+#include <iterator>
 #include <vector>
 
 #include "laser_object_tracker/data_types/laser_scan_fragment.hpp"
@@ -45,6 +46,17 @@ class BaseSegmentation {
  public:
   virtual std::vector<data_types::LaserScanFragment> segment(const data_types::LaserScanFragment& fragment) = 0;
 
+  /**
+   * @brief Segments fragment into a buffer owned by the caller.
+   * Buffer is cleared first, its capacity is kept, so reusing it between frames avoids reallocation.
+   */
+  virtual void segment(const data_types::LaserScanFragment& fragment,
+                       std::vector<data_types::LaserScanFragment>& segments) {
+    std::vector<data_types::LaserScanFragment> result = segment(fragment);
+    segments.clear();
+    std::move(result.begin(), result.end(), std::back_inserter(segments));
+  }
+
   virtual ~BaseSegmentation() = default;
 };
 }  // namespace segmentation
@@ -0,0 +1,428 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_SEGMENTATION_CHUNKED_SEGMENTATION_HPP
+#define LASER_OBJECT_TRACKER_SEGMENTATION_CHUNKED_SEGMENTATION_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "laser_object_tracker/data_types/laser_scan_fragment.hpp"
+
+namespace laser_object_tracker {
+namespace segmentation {
+
+/**
+ * @brief Splits a fragment into segments of valid elements at breakpoints, with the scan divided into angular chunks
+ * processed concurrently.
+ * Whether a segment starts or ends at an element depends only on the element and its predecessor, so every chunk
+ * emits segments starting within it and follows a segment over the seam into the next chunk if needed. Segments are
+ * then constructed into consecutive slots of the output, so the result is identical to a serial pass.
+ * Descriptors of segments are accumulated while their elements are checked for breakpoints, so neither the segments
+ * nor filters reading their descriptors walk the points again. Optionally segments at both ends of a full revolution
+ * scan, not separated by a breakpoint across the seam, are merged into the last one, and ends of segments are flagged
+ * as OcclusionDetection does. Chunks other than the first are processed by worker threads owned by the segmentation,
+ * which are started once and then reused for every scan.
+ */
+class ChunkedSegmentation {
+ public:
+  /**
+   * @param chunks_number Maximal number of chunks, 1 segments on the calling thread only
+   * @param min_chunk_size Minimal number of elements per chunk, smaller scans are split into fewer chunks
+   */
+  explicit ChunkedSegmentation(int chunks_number = 1, long min_chunk_size = 512) {
+    setChunksNumber(chunks_number);
+    setMinChunkSize(min_chunk_size);
+  }
+
+  ChunkedSegmentation(const ChunkedSegmentation&) = delete;
+
+  ChunkedSegmentation& operator=(const ChunkedSegmentation&) = delete;
+
+  ~ChunkedSegmentation() {
+    {
+      std::lock_guard<std::mutex> lock(workers_mutex_);
+      stopping_ = true;
+    }
+    work_condition_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  /**
+   * @brief Segments the fragment into a buffer, which is cleared first.
+   * @param is_breakpoint Callable taking previous and current valid elements, true if a segment ends between them
+   */
+  template<class IsBreakpoint>
+  void segment(const data_types::LaserScanFragment& fragment,
+               std::vector<data_types::LaserScanFragment>& segments,
+               IsBreakpoint is_breakpoint) {
+    segments.clear();
+    if (fragment.empty()) {
+      return;
+    }
+
+    const long size = fragment.size();
+    const int chunks = static_cast<int>(std::max(1L, std::min<long>(chunks_number_, size / min_chunk_size_)));
+    const long chunk_size = (size + chunks - 1) / chunks;
+    spans_.resize(chunks);
+
+    accumulators_.resize(chunks);
+    offsets_.assign(chunks + 1, 0);
+    forEachChunk(chunks,
+                 [&](int chunk) {
+                   findSpans(fragment, chunk * chunk_size, std::min(size, (chunk + 1) * chunk_size), is_breakpoint,
+                             accumulators_.at(chunk), spans_.at(chunk));
+                 },
+                 [&]() {
+                   for (int chunk = 0; chunk < chunks; ++chunk) {
+                     offsets_.at(chunk + 1) = offsets_.at(chunk) + spans_.at(chunk).size();
+                   }
+                   segments.resize(offsets_.back());
+                 },
+                 [&](int chunk) {
+                   long slot = offsets_.at(chunk);
+                   for (const auto& span : spans_.at(chunk)) {
+                     segments.at(slot++) = data_types::LaserScanFragment(fragment, span.first, span.last,
+                                                                         span.descriptor);
+                   }
+                 });
+
+    // A segment starting at the first element and one ending at the last element are distinct, if there are at least
+    // two segments, and both boundary elements are then valid
+    if (wrap_around_ && segments.size() > 1 && isFullRevolution(fragment) &&
+        firstSpan().first == 0 && lastSpan().last == size &&
+        !is_breakpoint(fragment[size - 1], fragment[0])) {
+      // The merged segment continues past angle max of the scan, so its angles stay monotonic
+      segments.back() = data_types::LaserScanFragment(segments.back(), segments.front());
+      segments.erase(segments.begin());
+    }
+
+    if (occlusion_angle_gap_ >= 0.0) {
+      data_types::flagOcclusions(segments, occlusion_angle_gap_);
+    }
+  }
+
+  /**
+   * @return True if elements of the fragment cover the full angle, so the first and the last one are neighbours
+   */
+  static bool isFullRevolution(const data_types::LaserScanFragment& fragment) {
+    const double increment = std::abs(fragment.getAngleIncrement());
+    return fragment.size() * increment >= 2.0 * M_PI - 0.5 * increment;
+  }
+
+  bool getWrapAround() const {
+    return wrap_around_;
+  }
+
+  /**
+   * @brief Enables merging of segments across the seam of full revolution scans.
+   */
+  void setWrapAround(bool wrap_around) {
+    wrap_around_ = wrap_around;
+  }
+
+  double getOcclusionAngleGap() const {
+    return occlusion_angle_gap_;
+  }
+
+  /**
+   * @brief Enables flagging ends of emitted segments as OcclusionDetection with the given max angle gap does,
+   * negative value disables it.
+   */
+  void setOcclusionAngleGap(double occlusion_angle_gap) {
+    occlusion_angle_gap_ = occlusion_angle_gap;
+  }
+
+  int getChunksNumber() const {
+    return chunks_number_;
+  }
+
+  void setChunksNumber(int chunks_number) {
+    if (chunks_number < 1) {
+      throw std::invalid_argument("Chunks number needs to be positive. Chunks number: " +
+          std::to_string(chunks_number));
+    }
+
+    chunks_number_ = chunks_number;
+  }
+
+  long getMinChunkSize() const {
+    return min_chunk_size_;
+  }
+
+  void setMinChunkSize(long min_chunk_size) {
+    if (min_chunk_size < 1) {
+      throw std::invalid_argument("Min chunk size needs to be positive. Min chunk size: " +
+          std::to_string(min_chunk_size));
+    }
+
+    min_chunk_size_ = min_chunk_size;
+  }
+
+ private:
+  /**
+   * @brief Range [first, last) of elements of a segment and its descriptor.
+   */
+  struct Span {
+    long first;
+    long last;
+    data_types::SegmentDescriptor descriptor;
+  };
+
+  using Spans = std::vector<Span>;
+
+  /**
+   * @brief Finds ranges of segments starting in [begin, end), last may lie beyond end, and computes their descriptors.
+   */
+  template<class IsBreakpoint>
+  static void findSpans(const data_types::LaserScanFragment& fragment, long begin, long end,
+                        IsBreakpoint& is_breakpoint, data_types::SegmentDescriptorAccumulator& accumulator,
+                        Spans& spans) {
+    spans.clear();
+    const long size = fragment.size();
+    for (long first = begin; first < end; ++first) {
+      bool starts = fragment[first].isValid() &&
+          (first == 0 || !fragment[first - 1].isValid() || is_breakpoint(fragment[first - 1], fragment[first]));
+      if (!starts) {
+        continue;
+      }
+
+      accumulator.clear();
+      accumulator.add(fragment[first].point());
+      long last = first + 1;
+      while (last < size && fragment[last].isValid() && !is_breakpoint(fragment[last - 1], fragment[last])) {
+        accumulator.add(fragment[last].point());
+        ++last;
+      }
+
+      spans.push_back({first, last});
+      accumulator.compute(spans.back().descriptor);
+      // Elements inside the segment do not start another one
+      first = last - 1;
+    }
+  }
+
+  const Span& firstSpan() const {
+    return std::find_if(spans_.begin(), spans_.end(), [](const Spans& spans) {return !spans.empty();})->front();
+  }
+
+  const Span& lastSpan() const {
+    return std::find_if(spans_.rbegin(), spans_.rend(), [](const Spans& spans) {return !spans.empty();})->back();
+  }
+
+  /**
+   * @brief Runs the first phase on every chunk, the completion once all chunks finished it and then the second phase on
+   * every chunk, so workers are woken once per scan. Chunk 0 runs on the calling thread.
+   * Workers are waited for before returning or rethrowing an exception of any phase, as phases refer to locals of the
+   * caller.
+   */
+  template<class FirstPhase, class Completion, class SecondPhase>
+  void forEachChunk(int chunks, FirstPhase first_phase, Completion completion, SecondPhase second_phase) {
+    arrived_ = 0;
+    released_ = false;
+    failed_ = false;
+    auto run = [&](int chunk) {
+      try {
+        first_phase(chunk);
+      } catch (...) {
+        arriveAndWait(chunks, false, completion);
+        throw;
+      }
+
+      if (arriveAndWait(chunks, true, completion)) {
+        second_phase(chunk);
+      }
+    };
+
+    if (chunks == 1) {
+      run(0);
+      return;
+    }
+
+    // Workers are started before any chunk runs, so failing to start one leaves no chunk waiting at the barrier
+    startWorkers(chunks - 1);
+    using Run = decltype(run);
+    dispatch(chunks - 1, [](void* task, int chunk) {(*static_cast<Run*>(task))(chunk);}, &run);
+
+    std::exception_ptr error;
+    try {
+      run(0);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    waitForWorkers();
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    for (int worker = 0; worker < chunks - 1; ++worker) {
+      if (errors_.at(worker)) {
+        std::rethrow_exception(errors_.at(worker));
+      }
+    }
+  }
+
+  /**
+   * @brief Starts workers, until there are at least workers_number of them.
+   */
+  void startWorkers(int workers_number) {
+    std::lock_guard<std::mutex> lock(workers_mutex_);
+    while (static_cast<int>(workers_.size()) < workers_number) {
+      // Worker waits for the generation following the current one, so it cannot miss a dispatched task
+      workers_.emplace_back(&ChunkedSegmentation::work, this, static_cast<int>(workers_.size()), generation_);
+      errors_.resize(workers_.size());
+    }
+  }
+
+  /**
+   * @brief Wakes workers_number first workers to run the task with chunks following the first one.
+   */
+  void dispatch(int workers_number, void (*task)(void*, int), void* context) {
+    {
+      std::lock_guard<std::mutex> lock(workers_mutex_);
+      task_ = task;
+      task_context_ = context;
+      active_workers_ = workers_number;
+      finished_workers_ = 0;
+      ++generation_;
+    }
+    work_condition_.notify_all();
+  }
+
+  void waitForWorkers() {
+    std::unique_lock<std::mutex> lock(workers_mutex_);
+    finished_condition_.wait(lock, [this]() {return finished_workers_ == active_workers_;});
+  }
+
+  void work(int worker, unsigned long generation) {
+    std::unique_lock<std::mutex> lock(workers_mutex_);
+    while (true) {
+      work_condition_.wait(lock, [&]() {return stopping_ || generation_ != generation;});
+      if (stopping_) {
+        return;
+      }
+
+      generation = generation_;
+      if (worker >= active_workers_) {
+        continue;
+      }
+
+      auto task = task_;
+      void* context = task_context_;
+      lock.unlock();
+      std::exception_ptr error;
+      try {
+        task(context, worker + 1);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      lock.lock();
+
+      errors_.at(worker) = error;
+      if (++finished_workers_ == active_workers_) {
+        finished_condition_.notify_one();
+      }
+    }
+  }
+
+  /**
+   * @brief Barrier between the phases of forEachChunk. The last chunk to arrive runs the completion, unless any chunk
+   * failed.
+   * @return True if all chunks succeeded and the completion did not throw
+   */
+  template<class Completion>
+  bool arriveAndWait(int chunks, bool succeeded, Completion& completion) {
+    std::unique_lock<std::mutex> lock(barrier_mutex_);
+    failed_ = failed_ || !succeeded;
+    if (++arrived_ < chunks) {
+      barrier_condition_.wait(lock, [this]() {return released_;});
+      return !failed_;
+    }
+
+    if (!failed_) {
+      try {
+        completion();
+      } catch (...) {
+        failed_ = true;
+        released_ = true;
+        barrier_condition_.notify_all();
+        throw;
+      }
+    }
+
+    released_ = true;
+    barrier_condition_.notify_all();
+    return !failed_;
+  }
+
+  int chunks_number_;
+  long min_chunk_size_;
+  bool wrap_around_ = false;
+  double occlusion_angle_gap_ = -1.0;
+
+  std::vector<Spans> spans_;
+  std::vector<data_types::SegmentDescriptorAccumulator> accumulators_;
+  std::vector<long> offsets_;
+
+  std::mutex barrier_mutex_;
+  std::condition_variable barrier_condition_;
+  int arrived_ = 0;
+  bool released_ = false;
+  bool failed_ = false;
+
+  std::vector<std::thread> workers_;
+  /** @brief Exception thrown by the task of every worker, empty if it succeeded */
+  std::vector<std::exception_ptr> errors_;
+  void (*task_)(void*, int) = nullptr;
+  void* task_context_ = nullptr;
+  int active_workers_ = 0;
+  int finished_workers_ = 0;
+  unsigned long generation_ = 0;
+  bool stopping_ = false;
+  std::mutex workers_mutex_;
+  std::condition_variable work_condition_;
+  std::condition_variable finished_condition_;
+};
+}  // namespace segmentation
+}  // namespace laser_object_tracker
+
+#endif  // LASER_OBJECT_TRACKER_SEGMENTATION_CHUNKED_SEGMENTATION_HPP
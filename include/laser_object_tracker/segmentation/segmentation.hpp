@@ -35,8 +35,10 @@
 #define LASER_OBJECT_TRACKER_SEGMENTATION_SEGMENTATION_HPP
 
 #include "laser_object_tracker/segmentation/adaptive_breakpoint_detection.hpp"
+#include "laser_object_tracker/segmentation/background_subtraction.hpp"
 #include "laser_object_tracker/segmentation/base_segmentation.hpp"
 #include "laser_object_tracker/segmentation/breakpoint_detection.hpp"
+#include "laser_object_tracker/segmentation/chunked_segmentation.hpp"
 #include "laser_object_tracker/segmentation/distance_calculation.hpp"
 
 #endif  // LASER_OBJECT_TRACKER_SEGMENTATION_SEGMENTATION_HPP
@@ -48,6 +48,13 @@ class BaseTrackerRejection {
   virtual void notUpdated(const BaseTracking& tracker) {}
 
   virtual std::unique_ptr<BaseTrackerRejection> clone() const = 0;
+
+  /**
+   * @brief Reinitializes this rejection in place to the state of the prototype.
+   */
+  virtual void resetFrom(const BaseTrackerRejection& prototype) = 0;
+
+  virtual ~BaseTrackerRejection() = default;
 };
 
 }  // namespace tracking
@@ -55,12 +55,22 @@ class BaseTracking {
 
   virtual void predict() = 0;
 
+  /**
+   * @brief Predicts state after time_step seconds. By default time step is ignored.
+   */
+  virtual void predict(double time_step);
+
   virtual void update(const Eigen::VectorXd& measurement) = 0;
 
   virtual Eigen::VectorXd getStateVector() const = 0;
 
   virtual std::unique_ptr<BaseTracking> clone() const = 0;
 
+  /**
+   * @brief Reinitializes this tracker in place to the state of the prototype, reusing owned buffers.
+   */
+  virtual void resetFrom(const BaseTracking& prototype) = 0;
+
   virtual ~BaseTracking() = default;
 
  protected:
@@ -51,6 +51,8 @@ class IterationTrackerRejection : public BaseTrackerRejection {
 
   std::unique_ptr<BaseTrackerRejection> clone() const override;
 
+  void resetFrom(const BaseTrackerRejection& prototype) override;
+
   int getMaxIterationsWithoutUpdate() const;
 
   void setMaxIterationsWithoutUpdate(int max_iterations_without_update);
@@ -37,6 +37,7 @@
 #include <opencv2/video/tracking.hpp>
 
 #include "laser_object_tracker/tracking/base_tracking.hpp"
+#include "laser_object_tracker/tracking/motion_model_cache.hpp"
 
 namespace laser_object_tracker {
 namespace tracking {
@@ -64,17 +65,27 @@ class KalmanFilter : public BaseTracking {
 
   void predict() override;
 
+  /**
+   * @brief Predicts with transition and process noise taken from motion model cache, if one is set.
+   */
+  void predict(double time_step) override;
+
   void update(const Eigen::VectorXd& measurement) override;
 
   Eigen::VectorXd getStateVector() const override;
 
   std::unique_ptr<BaseTracking> clone() const override;
 
+  void resetFrom(const BaseTracking& prototype) override;
+
+  void setMotionModelCache(std::shared_ptr<MotionModelCache> motion_model_cache);
+
 private:
   void copyMats(const KalmanFilter& other);
 
   cv::KalmanFilter kalman_filter_;
   cv::Mat inverse_measurement_matrix_;
+  std::shared_ptr<MotionModelCache> motion_model_cache_;
 };
 }  // namespace tracking
 }  // namespace laser_object_tracker
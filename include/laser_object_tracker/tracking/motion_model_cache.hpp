@@ -0,0 +1,74 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_TRACKING_MOTION_MODEL_CACHE_HPP
+#define LASER_OBJECT_TRACKER_TRACKING_MOTION_MODEL_CACHE_HPP
+
+#include <memory>
+#include <vector>
+
+#include "laser_object_tracker/tracking/base_motion_model.hpp"
+
+namespace laser_object_tracker {
+namespace tracking {
+
+/**
+ * @brief Direct mapped table of discretized motion models, keyed by time step quantized to time_step_quantum.
+ * Matrices are recomputed only when a different quantized time step occupies the slot.
+ */
+class MotionModelCache {
+ public:
+  struct Entry {
+    long key = -1;
+    double time_step = 0.0;
+    Eigen::MatrixXd transition_matrix;
+    Eigen::MatrixXd process_noise_covariance;
+  };
+
+  MotionModelCache(std::unique_ptr<BaseMotionModel> motion_model, double time_step_quantum, int size);
+
+  const Entry& get(double time_step);
+
+  double getTimeStepQuantum() const;
+
+  int size() const;
+
+ private:
+  std::unique_ptr<BaseMotionModel> motion_model_;
+  double time_step_quantum_;
+  std::vector<Entry> entries_;
+};
+}  // namespace tracking
+}  // namespace laser_object_tracker
+
+#endif //LASER_OBJECT_TRACKER_TRACKING_MOTION_MODEL_CACHE_HPP
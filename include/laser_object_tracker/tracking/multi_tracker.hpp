@@ -37,14 +37,23 @@
 #include <vector>
 
 #include "laser_object_tracker/data_association/base_data_association.hpp"
+#include "laser_object_tracker/data_types/frame_arena.hpp"
 #include "laser_object_tracker/tracking/base_tracker_rejection.hpp"
 #include "laser_object_tracker/tracking/base_tracking.hpp"
+#include "laser_object_tracker/tracking/object_pool.hpp"
 
 namespace laser_object_tracker {
 namespace tracking {
 class MultiTracker {
  public:
   using DistanceFunctor = std::function<double(const Eigen::VectorXd&, const BaseTracking&)>;
+  using CostMatrix = data_association::BaseDataAssociation::CostMatrix;
+
+  /**
+   * @brief Marks measurement, which association differs between competing hypotheses.
+   * Such measurement neither updates any track nor initializes a new one.
+   */
+  static constexpr int AMBIGUOUS_ASSIGNMENT = -2;
 
   MultiTracker(DistanceFunctor distance_calculator,
                std::unique_ptr<data_association::BaseDataAssociation> data_association,
@@ -53,11 +62,23 @@ class MultiTracker {
 
   void predict();
 
+  void predict(double time_step);
+
   void update(const std::vector<Eigen::VectorXd>& measurements);
 
   Eigen::MatrixXd buildCostMatrix(const std::vector<Eigen::VectorXd>& measurements);
 
-  Eigen::VectorXi buildAssignmentVector(const Eigen::MatrixXd& cost_matrix);
+  Eigen::VectorXi buildAssignmentVector(const CostMatrix& cost_matrix);
+
+  std::vector<Eigen::VectorXi> buildAssignmentHypotheses(const CostMatrix& cost_matrix,
+                                                         std::vector<double>& costs);
+
+  /**
+   * @brief Keeps assignments of the first hypothesis shared by every hypothesis with cost within margin from it.
+   * Throws std::invalid_argument if there are no hypotheses.
+   */
+  Eigen::VectorXi resolveAssignmentHypotheses(const std::vector<Eigen::VectorXi>& assignment_vectors,
+                                              const std::vector<double>& costs);
 
   void updateAndInitializeTracks(const std::vector<Eigen::VectorXd>& measurements,
                                  const Eigen::VectorXi& assignment_vector);
@@ -78,15 +99,53 @@ class MultiTracker {
 
   int size() const;
 
+  /**
+   * @brief Preallocates storage and pooled trackers, so that up to tracks_number tracks do not allocate.
+   */
+  void reserve(int tracks_number);
+
+  /**
+   * @brief Enables bounded hypothesis mode, if max_hypotheses is greater than 1.
+   * Only assignments shared by every hypothesis with cost within margin from the best one are applied.
+   */
+  void setMaxHypotheses(int max_hypotheses, double hypothesis_cost_margin);
+
+  /**
+   * @brief Makes update() build the cost matrix in memory drawn from the arena instead of the heap.
+   * The arena has to outlive the update call and is not reset by the tracker, nullptr restores heap allocation.
+   */
+  void setFrameArena(data_types::FrameArena* frame_arena) {
+    frame_arena_ = frame_arena;
+  }
+
+  int getMaxHypotheses() const {
+    return max_hypotheses_;
+  }
+
+  double getHypothesisCostMargin() const {
+    return hypothesis_cost_margin_;
+  }
+
  private:
+  void fillCostMatrix(const std::vector<Eigen::VectorXd>& measurements, Eigen::Ref<Eigen::MatrixXd> cost_matrix) const;
+
+  void updateWithCostMatrix(const std::vector<Eigen::VectorXd>& measurements, const CostMatrix& cost_matrix);
+
   DistanceFunctor distance_calculator_;
   std::unique_ptr<data_association::BaseDataAssociation> data_association_;
+  int max_hypotheses_ = 1;
+  double hypothesis_cost_margin_ = 0.0;
 
-  std::unique_ptr<BaseTracking> tracker_prototype_;
+  ObjectPool<BaseTracking> trackers_pool_;
   std::vector<std::unique_ptr<BaseTracking>> trackers_;
 
-  std::unique_ptr<BaseTrackerRejection> tracker_rejector_prototype_;
+  ObjectPool<BaseTrackerRejection> trackers_rejections_pool_;
   std::vector<std::unique_ptr<BaseTrackerRejection>> trackers_rejections_;
+
+  std::vector<bool> updated_trackers_;
+
+  data_types::FrameArena* frame_arena_ = nullptr;
+  Eigen::VectorXi assignment_vector_;
 };
 }  // namespace tracking
 }  // namespace laser_object_tracker
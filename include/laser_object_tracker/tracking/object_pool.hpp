@@ -0,0 +1,103 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef LASER_OBJECT_TRACKER_TRACKING_OBJECT_POOL_HPP
+#define LASER_OBJECT_TRACKER_TRACKING_OBJECT_POOL_HPP
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace laser_object_tracker {
+namespace tracking {
+
+/**
+ * @brief Recycles objects created from a prototype.
+ * Released objects are kept and reinitialized in place with resetFrom() on next acquire,
+ * so only growth of the pool allocates.
+ * @tparam T Type providing clone() and resetFrom(const T&)
+ */
+template<class T>
+class ObjectPool {
+ public:
+  explicit ObjectPool(std::unique_ptr<T> prototype) : prototype_(std::move(prototype)), created_(0) {
+    if (!prototype_) {
+      throw std::invalid_argument("Object pool prototype cannot be empty.");
+    }
+  }
+
+  std::unique_ptr<T> acquire() {
+    if (objects_.empty()) {
+      ++created_;
+      return prototype_->clone();
+    }
+
+    std::unique_ptr<T> object = std::move(objects_.back());
+    objects_.pop_back();
+    object->resetFrom(*prototype_);
+    return object;
+  }
+
+  void release(std::unique_ptr<T> object) {
+    if (object) {
+      objects_.push_back(std::move(object));
+    }
+  }
+
+  /**
+   * @brief Constructs objects up front, so that acquiring and releasing up to size objects does not allocate.
+   */
+  void reserve(int size) {
+    objects_.reserve(size);
+    for (; created_ < size; ++created_) {
+      objects_.push_back(prototype_->clone());
+    }
+  }
+
+  int available() const {
+    return objects_.size();
+  }
+
+  const T& prototype() const {
+    return *prototype_;
+  }
+
+ private:
+  std::unique_ptr<T> prototype_;
+  std::vector<std::unique_ptr<T>> objects_;
+  int created_;
+};
+}  // namespace tracking
+}  // namespace laser_object_tracker
+
+#endif //LASER_OBJECT_TRACKER_TRACKING_OBJECT_POOL_HPP
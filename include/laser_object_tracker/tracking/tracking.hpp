@@ -35,9 +35,13 @@
 #define LASER_OBJECT_TRACKER_TRACKING_TRACKING_HPP
 
 #include "laser_object_tracker/tracking/base_tracker_rejection.hpp"
+#include "laser_object_tracker/tracking/base_motion_model.hpp"
 #include "laser_object_tracker/tracking/base_tracking.hpp"
+#include "laser_object_tracker/tracking/constant_velocity_motion_model.hpp"
 #include "laser_object_tracker/tracking/iteration_tracker_rejection.hpp"
 #include "laser_object_tracker/tracking/kalman_filter.hpp"
+#include "laser_object_tracker/tracking/motion_model_cache.hpp"
 #include "laser_object_tracker/tracking/multi_tracker.hpp"
+#include "laser_object_tracker/tracking/object_pool.hpp"
 
 #endif  // LASER_OBJECT_TRACKER_TRACKING_TRACKING_HPP
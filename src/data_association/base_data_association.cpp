@@ -33,11 +33,27 @@
 
 #include "laser_object_tracker/data_association/base_data_association.hpp"
 
+#include <stdexcept>
+#include <string>
+
 namespace laser_object_tracker {
 namespace data_association {
 constexpr int BaseDataAssociation::NO_ASSIGNMENT;
 const Eigen::MatrixXd BaseDataAssociation::NOT_NEEDED = Eigen::MatrixXd();
 
 BaseDataAssociation::BaseDataAssociation(double max_allowed_cost) : max_allowed_cost_(max_allowed_cost) {}
+
+void BaseDataAssociation::solveKBest(const CostMatrix& cost_matrix,
+                                     int k,
+                                     std::vector<Eigen::VectorXi>& assignment_vectors,
+                                     std::vector<double>& costs) {
+  if (k < 1) {
+    throw std::invalid_argument("Number of requested assignments needs to be positive. k: " + std::to_string(k));
+  }
+
+  assignment_vectors.resize(1);
+  costs.resize(1);
+  costs.front() = solve(cost_matrix, NOT_NEEDED, assignment_vectors.front());
+}
 }  // namespace data_association
 }  // namespace laser_object_tracker
@@ -38,7 +38,7 @@ namespace data_association {
 
 HungarianAlgorithm::HungarianAlgorithm(double max_allowed_cost) : BaseDataAssociation(max_allowed_cost) {}
 
-double HungarianAlgorithm::solve(const Eigen::MatrixXd& cost_matrix,
+double HungarianAlgorithm::solve(const CostMatrix& cost_matrix,
                                  const Eigen::MatrixXd& covariance_matrix,
                                  Eigen::VectorXi& assignment_vector) {
   if (cost_matrix.size() == 0) {
@@ -46,23 +46,34 @@ double HungarianAlgorithm::solve(const Eigen::MatrixXd& cost_matrix,
     return 0.0;
   }
 
-  min_dimension_ = std::min(cost_matrix.rows(), cost_matrix.cols());
-  Eigen::ArrayXXd cost_matrix_copy = cost_matrix.array();
-  assignment_vector.setConstant(cost_matrix.cols(), NO_ASSIGNMENT);
+  const Eigen::Index rows = cost_matrix.rows(), cols = cost_matrix.cols();
+  min_dimension_ = std::min(rows, cols);
+  assignment_vector.setConstant(cols, NO_ASSIGNMENT);
 
-  star_matrix_.setConstant(cost_matrix.rows(), cost_matrix.cols(), false);
-  new_star_matrix_.setConstant(cost_matrix.rows(), cost_matrix.cols(), false);
-  prime_matrix_.setConstant(cost_matrix.rows(), cost_matrix.cols(), false);
-  covered_columns_.setConstant(cost_matrix.cols(), false);
-  covered_rows_.setConstant(cost_matrix.rows(), false);
+  scratch_.reset();
+  ScratchArray cost_matrix_copy(scratch_.allocate<double>(rows * cols), rows, cols);
+  cost_matrix_copy = cost_matrix.array();
+
+  // Placement new is the way of rebinding Eigen::Map to other memory
+  new (&star_matrix_) Eigen::Map<Eigen::ArrayXXb>(scratch_.allocate<bool>(rows * cols), rows, cols);
+  new (&new_star_matrix_) Eigen::Map<Eigen::ArrayXXb>(scratch_.allocate<bool>(rows * cols), rows, cols);
+  new (&prime_matrix_) Eigen::Map<Eigen::ArrayXXb>(scratch_.allocate<bool>(rows * cols), rows, cols);
+  new (&covered_columns_) Eigen::Map<Eigen::RowArrayXb>(scratch_.allocate<bool>(cols), cols);
+  new (&covered_rows_) Eigen::Map<Eigen::ArrayXb>(scratch_.allocate<bool>(rows), rows);
+
+  star_matrix_.setConstant(false);
+  new_star_matrix_.setConstant(false);
+  prime_matrix_.setConstant(false);
+  covered_columns_.setConstant(false);
+  covered_rows_.setConstant(false);
 
 
   // Call solving function
   return assignmentOptimal(cost_matrix, cost_matrix_copy, assignment_vector);
 }
 
-double HungarianAlgorithm::assignmentOptimal(const Eigen::MatrixXd& cost_matrix,
-                                             Eigen::ArrayXXd& cost_matrix_copy,
+double HungarianAlgorithm::assignmentOptimal(const CostMatrix& cost_matrix,
+                                             ScratchArray& cost_matrix_copy,
                                              Eigen::VectorXi& assignment) {
   // Preliminary steps
   if (cost_matrix_copy.rows() <= cost_matrix_copy.cols()) {
@@ -107,8 +118,8 @@ double HungarianAlgorithm::assignmentOptimal(const Eigen::MatrixXd& cost_matrix,
   return computeAssignmentCost(cost_matrix, cost_matrix_copy, assignment);
 }
 
-void HungarianAlgorithm::buildAssignmentVector(const Eigen::MatrixXd& cost_matrix,
-                                               Eigen::ArrayXXd& cost_matrix_copy,
+void HungarianAlgorithm::buildAssignmentVector(const CostMatrix& cost_matrix,
+                                               ScratchArray& cost_matrix_copy,
                                                Eigen::VectorXi& assignment) {
   for (int row = 0; row < star_matrix_.rows(); ++row) {
     for (int col = 0; col < star_matrix_.cols(); ++col) {
@@ -121,8 +132,8 @@ void HungarianAlgorithm::buildAssignmentVector(const Eigen::MatrixXd& cost_matri
   }
 }
 
-double HungarianAlgorithm::computeAssignmentCost(const Eigen::MatrixXd& cost_matrix,
-                                                 Eigen::ArrayXXd& cost_matrix_copy,
+double HungarianAlgorithm::computeAssignmentCost(const CostMatrix& cost_matrix,
+                                                 ScratchArray& cost_matrix_copy,
                                                  Eigen::VectorXi& assignment) {
   double cost = 0.0;
   int row = 0;
@@ -136,8 +147,8 @@ double HungarianAlgorithm::computeAssignmentCost(const Eigen::MatrixXd& cost_mat
   return cost;
 }
 
-void HungarianAlgorithm::step2a(const Eigen::MatrixXd& cost_matrix,
-                                Eigen::ArrayXXd& cost_matrix_copy,
+void HungarianAlgorithm::step2a(const CostMatrix& cost_matrix,
+                                ScratchArray& cost_matrix_copy,
                                 Eigen::VectorXi& assignment) {
   // Cover every column containing a starred zero
   covered_columns_ = covered_columns_ || star_matrix_.colwise().any();
@@ -145,8 +156,8 @@ void HungarianAlgorithm::step2a(const Eigen::MatrixXd& cost_matrix,
   step2b(cost_matrix, cost_matrix_copy, assignment);
 }
 
-void HungarianAlgorithm::step2b(const Eigen::MatrixXd& cost_matrix,
-                                Eigen::ArrayXXd& cost_matrix_copy,
+void HungarianAlgorithm::step2b(const CostMatrix& cost_matrix,
+                                ScratchArray& cost_matrix_copy,
                                 Eigen::VectorXi& assignment) {
   // Count covered columns
   if (covered_columns_.count() == min_dimension_) {
@@ -158,8 +169,8 @@ void HungarianAlgorithm::step2b(const Eigen::MatrixXd& cost_matrix,
   }
 }
 
-void HungarianAlgorithm::step3(const Eigen::MatrixXd& cost_matrix,
-                               Eigen::ArrayXXd& cost_matrix_copy,
+void HungarianAlgorithm::step3(const CostMatrix& cost_matrix,
+                               ScratchArray& cost_matrix_copy,
                                Eigen::VectorXi& assignment) {
   bool zeros_found = true;
   while (zeros_found) {
@@ -194,8 +205,8 @@ void HungarianAlgorithm::step3(const Eigen::MatrixXd& cost_matrix,
   step5(cost_matrix, cost_matrix_copy, assignment);
 }
 
-void HungarianAlgorithm::step4(const Eigen::MatrixXd& cost_matrix,
-                               Eigen::ArrayXXd& cost_matrix_copy,
+void HungarianAlgorithm::step4(const CostMatrix& cost_matrix,
+                               ScratchArray& cost_matrix_copy,
                                Eigen::VectorXi& assignment,
                                int row,
                                int column) {
@@ -234,17 +245,21 @@ void HungarianAlgorithm::step4(const Eigen::MatrixXd& cost_matrix,
   step2a(cost_matrix, cost_matrix_copy, assignment);
 }
 
-void HungarianAlgorithm::step5(const Eigen::MatrixXd& cost_matrix,
-                               Eigen::ArrayXXd& cost_matrix_copy,
+void HungarianAlgorithm::step5(const CostMatrix& cost_matrix,
+                               ScratchArray& cost_matrix_copy,
                                Eigen::VectorXi& assignment) {
-  // We need to find the smallest uncovered element.
-  // In order to do this we create matrix indicating which elements are not covered.
-  // The element is not covered, if its row and column is not covered, hence multiplication representing logical AND.
-  double min_uncovered = ((!covered_rows_).matrix() * (!covered_columns_).matrix())
-      // If the element is not covered, take its value from cost_matrix, otherwise its max
-      .select(cost_matrix_copy, std::numeric_limits<double>::max())
-          // Find the smallest element
-      .minCoeff();
+  // We need to find the smallest uncovered element, e.g. one which neither row nor column is covered.
+  // It is searched for directly, as the mask of uncovered elements would be a temporary matrix.
+  double min_uncovered = std::numeric_limits<double>::max();
+  for (int col = 0; col < cost_matrix_copy.cols(); ++col) {
+    if (!covered_columns_(col)) {
+      for (int row = 0; row < cost_matrix_copy.rows(); ++row) {
+        if (!covered_rows_(row)) {
+          min_uncovered = std::min(min_uncovered, cost_matrix_copy(row, col));
+        }
+      }
+    }
+  }
 
   // Add min_uncovered to each covered row
   cost_matrix_copy = covered_rows_.replicate(1, covered_columns_.size()).
@@ -0,0 +1,376 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "laser_object_tracker/data_association/murty_algorithm.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace laser_object_tracker {
+namespace data_association {
+
+MurtyAlgorithm::MurtyAlgorithm(double max_allowed_cost) : BaseDataAssociation(max_allowed_cost) {}
+
+double MurtyAlgorithm::solve(const CostMatrix& cost_matrix,
+                             const Eigen::MatrixXd& covariance_matrix,
+                             Eigen::VectorXi& assignment_vector) {
+  std::vector<Eigen::VectorXi> assignment_vectors;
+  std::vector<double> costs;
+  solveKBest(cost_matrix, 1, assignment_vectors, costs);
+
+  if (assignment_vectors.empty()) {
+    assignment_vector.setConstant(cost_matrix.cols(), NO_ASSIGNMENT);
+    return 0.0;
+  }
+
+  assignment_vector = std::move(assignment_vectors.front());
+  return costs.front();
+}
+
+void MurtyAlgorithm::solveKBest(const CostMatrix& cost_matrix,
+                                int k,
+                                std::vector<Eigen::VectorXi>& assignment_vectors,
+                                std::vector<double>& costs) {
+  if (k < 1) {
+    throw std::invalid_argument("Number of requested assignments needs to be positive. k: " + std::to_string(k));
+  }
+
+  assignment_vectors.clear();
+  costs.clear();
+
+  if (cost_matrix.size() == 0) {
+    assignment_vectors.push_back(Eigen::VectorXi::Constant(cost_matrix.cols(), NO_ASSIGNMENT));
+    costs.push_back(0.0);
+    return;
+  }
+
+  buildSquareCostMatrix(cost_matrix);
+  queue_.clear();
+  forbidden_pairs_.clear();
+  free_solutions_.clear();
+  for (int solution = 0; solution < static_cast<int>(solutions_.size()); ++solution) {
+    free_solutions_.push_back(solution);
+  }
+
+  Subproblem root;
+  if (!solveRoot(root)) {
+    return;
+  }
+  pushSubproblem(root);
+
+  Eigen::VectorXi assignment_vector;
+  while (!queue_.empty()) {
+    Subproblem subproblem = popSubproblem();
+
+    // Lazily evaluated child, its cost is only a lower bound
+    if (subproblem.free_row != NO_ASSIGNMENT) {
+      if (solveChild(subproblem)) {
+        pushSubproblem(subproblem);
+      }
+      continue;
+    }
+
+    buildAssignmentVector(cost_matrix, solutions_.at(subproblem.solution), assignment_vector);
+    // Different assignments may become equal after removing pairs exceeding max allowed cost
+    if (std::find(assignment_vectors.begin(), assignment_vectors.end(), assignment_vector) ==
+        assignment_vectors.end()) {
+      assignment_vectors.push_back(assignment_vector);
+      costs.push_back(gatedCost(cost_matrix, assignment_vector));
+
+      if (static_cast<int>(assignment_vectors.size()) == k) {
+        break;
+      }
+    }
+
+    partition(subproblem);
+    releaseSolution(subproblem.solution);
+  }
+}
+
+bool MurtyAlgorithm::SubproblemCompare::operator()(const Subproblem& lhs, const Subproblem& rhs) const {
+  // On equal costs prefer already solved subproblems, since they can be returned right away
+  if (lhs.cost == rhs.cost) {
+    return lhs.free_row != NO_ASSIGNMENT && rhs.free_row == NO_ASSIGNMENT;
+  }
+  return lhs.cost > rhs.cost;
+}
+
+void MurtyAlgorithm::buildSquareCostMatrix(const CostMatrix& cost_matrix) {
+  // Rows of internal matrix always correspond to the smaller dimension, remaining rows are zero cost dummies
+  transposed_ = cost_matrix.rows() > cost_matrix.cols();
+  rows_ = std::min(cost_matrix.rows(), cost_matrix.cols());
+  Eigen::Index size = std::max(cost_matrix.rows(), cost_matrix.cols());
+
+  square_cost_matrix_.setZero(size, size);
+  if (transposed_) {
+    square_cost_matrix_.topRows(rows_) = cost_matrix.transpose();
+  } else {
+    square_cost_matrix_.topRows(rows_) = cost_matrix;
+  }
+}
+
+bool MurtyAlgorithm::solveRoot(Subproblem& subproblem) {
+  int size = static_cast<int>(square_cost_matrix_.rows());
+  subproblem.solution = acquireSolution();
+  Solution& solution = solutions_.at(subproblem.solution);
+  solution.row_to_column.assign(size, NO_ASSIGNMENT);
+  solution.column_to_row.assign(size, NO_ASSIGNMENT);
+  solution.column_potentials.assign(size, 0.0);
+
+  for (int row = 0; row < size; ++row) {
+    if (!augment(row, 0, solution)) {
+      releaseSolution(subproblem.solution);
+      return false;
+    }
+  }
+
+  subproblem.free_row = NO_ASSIGNMENT;
+  subproblem.fixed_rows = 0;
+  subproblem.forbidden = NO_ASSIGNMENT;
+  subproblem.cost = computeCost(solution);
+  return true;
+}
+
+bool MurtyAlgorithm::solveChild(Subproblem& subproblem) {
+  // Acquiring may grow the storage, so references into it are taken afterwards
+  int index = acquireSolution();
+  Solution& solution = solutions_.at(index);
+  const Solution& parent = solutions_.at(subproblem.solution);
+  solution.row_to_column.assign(parent.row_to_column.begin(), parent.row_to_column.end());
+  solution.column_to_row.assign(parent.column_to_row.begin(), parent.column_to_row.end());
+  solution.column_potentials.assign(parent.column_potentials.begin(), parent.column_potentials.end());
+  releaseSolution(subproblem.solution);
+  subproblem.solution = index;
+
+  int free_row = subproblem.free_row;
+  solution.column_to_row.at(solution.row_to_column.at(free_row)) = NO_ASSIGNMENT;
+  solution.row_to_column.at(free_row) = NO_ASSIGNMENT;
+
+  forbidden_costs_.clear();
+  for (int pair = subproblem.forbidden; pair != NO_ASSIGNMENT; pair = forbidden_pairs_.at(pair).previous) {
+    const ForbiddenPair& forbidden = forbidden_pairs_.at(pair);
+    forbidden_costs_.push_back(square_cost_matrix_(forbidden.row, forbidden.column));
+    square_cost_matrix_(forbidden.row, forbidden.column) = std::numeric_limits<double>::infinity();
+  }
+
+  bool feasible = augment(free_row, subproblem.fixed_rows, solution);
+
+  auto forbidden_cost = forbidden_costs_.begin();
+  for (int pair = subproblem.forbidden; pair != NO_ASSIGNMENT; pair = forbidden_pairs_.at(pair).previous) {
+    const ForbiddenPair& forbidden = forbidden_pairs_.at(pair);
+    square_cost_matrix_(forbidden.row, forbidden.column) = *forbidden_cost++;
+  }
+
+  if (!feasible) {
+    releaseSolution(index);
+    return false;
+  }
+
+  subproblem.free_row = NO_ASSIGNMENT;
+  subproblem.cost = computeCost(solution);
+  return true;
+}
+
+bool MurtyAlgorithm::augment(int free_row, int fixed_rows, Solution& solution) {
+  // Dijkstra search of the shortest augmenting path over reduced costs
+  Eigen::Index size = square_cost_matrix_.rows();
+  std::vector<double>& potentials = solution.column_potentials;
+
+  distances_.resize(size);
+  predecessors_.resize(size);
+  done_columns_.assign(size, false);
+  scanned_columns_.clear();
+
+  for (int col = 0; col < size; ++col) {
+    int row = solution.column_to_row[col];
+    if (row != NO_ASSIGNMENT && row < fixed_rows) {
+      // Columns of fixed pairs do not take part in the subproblem
+      done_columns_.at(col) = true;
+    } else {
+      distances_(col) = square_cost_matrix_(free_row, col) - potentials[col];
+      predecessors_(col) = free_row;
+    }
+  }
+
+  int column;
+  double min_distance;
+  while (true) {
+    column = NO_ASSIGNMENT;
+    min_distance = std::numeric_limits<double>::infinity();
+    for (int col = 0; col < size; ++col) {
+      if (!done_columns_.at(col) && distances_(col) < min_distance) {
+        min_distance = distances_(col);
+        column = col;
+      }
+    }
+
+    if (column == NO_ASSIGNMENT) {
+      // Every remaining column is forbidden
+      return false;
+    }
+
+    int row = solution.column_to_row[column];
+    if (row == NO_ASSIGNMENT) {
+      break;
+    }
+
+    done_columns_.at(column) = true;
+    scanned_columns_.push_back(column);
+
+    double offset = min_distance - square_cost_matrix_(row, column) + potentials[column];
+    for (int col = 0; col < size; ++col) {
+      if (!done_columns_.at(col)) {
+        double distance = offset + square_cost_matrix_(row, col) - potentials[col];
+        if (distance < distances_(col)) {
+          distances_(col) = distance;
+          predecessors_(col) = row;
+        }
+      }
+    }
+  }
+
+  // Keep reduced costs non-negative
+  for (int col : scanned_columns_) {
+    potentials[col] += distances_(col) - min_distance;
+  }
+
+  // Flip assignments along the path
+  int row;
+  do {
+    row = predecessors_(column);
+    solution.column_to_row[column] = row;
+    std::swap(column, solution.row_to_column[row]);
+  } while (row != free_row);
+
+  return true;
+}
+
+double MurtyAlgorithm::computeCost(const Solution& solution) const {
+  double cost = 0.0;
+  for (int row = 0; row < rows_; ++row) {
+    cost += square_cost_matrix_(row, solution.row_to_column[row]);
+  }
+  return cost;
+}
+
+void MurtyAlgorithm::partition(const Subproblem& parent) {
+  const Solution& solution = solutions_.at(parent.solution);
+  const std::vector<double>& potentials = solution.column_potentials;
+
+  // Child of every row fixes all rows before it, so rows below the freed one are exactly the fixed ones
+  for (int row = parent.fixed_rows; row < rows_; ++row) {
+    int column = solution.row_to_column[row];
+
+    // Every augmenting path starts with an edge from the freed row, its reduced cost bounds the cost increase
+    double min_reduced_cost = std::numeric_limits<double>::infinity();
+    for (int col = 0; col < square_cost_matrix_.cols(); ++col) {
+      if (col != column && solution.column_to_row[col] >= row) {
+        min_reduced_cost = std::min(min_reduced_cost, square_cost_matrix_(row, col) - potentials[col]);
+      }
+    }
+
+    if (min_reduced_cost != std::numeric_limits<double>::infinity()) {
+      forbidden_pairs_.push_back({row, column, parent.forbidden});
+
+      Subproblem child;
+      child.cost = parent.cost +
+          std::max(0.0, min_reduced_cost - square_cost_matrix_(row, column) + potentials[column]);
+      child.free_row = row;
+      child.fixed_rows = row;
+      child.forbidden = static_cast<int>(forbidden_pairs_.size()) - 1;
+      child.solution = parent.solution;
+      ++solutions_.at(parent.solution).references;
+
+      pushSubproblem(child);
+    }
+  }
+}
+
+void MurtyAlgorithm::pushSubproblem(const Subproblem& subproblem) {
+  queue_.push_back(subproblem);
+  std::push_heap(queue_.begin(), queue_.end(), SubproblemCompare());
+}
+
+MurtyAlgorithm::Subproblem MurtyAlgorithm::popSubproblem() {
+  std::pop_heap(queue_.begin(), queue_.end(), SubproblemCompare());
+  Subproblem subproblem = queue_.back();
+  queue_.pop_back();
+  return subproblem;
+}
+
+int MurtyAlgorithm::acquireSolution() {
+  int solution;
+  if (free_solutions_.empty()) {
+    solution = static_cast<int>(solutions_.size());
+    solutions_.emplace_back();
+  } else {
+    solution = free_solutions_.back();
+    free_solutions_.pop_back();
+  }
+
+  solutions_.at(solution).references = 1;
+  return solution;
+}
+
+void MurtyAlgorithm::releaseSolution(int solution) {
+  if (--solutions_.at(solution).references == 0) {
+    free_solutions_.push_back(solution);
+  }
+}
+
+double MurtyAlgorithm::gatedCost(const CostMatrix& cost_matrix, const Eigen::VectorXi& assignment_vector) {
+  double cost = 0.0;
+  for (int col = 0; col < assignment_vector.size(); ++col) {
+    if (assignment_vector(col) != NO_ASSIGNMENT) {
+      cost += cost_matrix(assignment_vector(col), col);
+    }
+  }
+  return cost;
+}
+
+void MurtyAlgorithm::buildAssignmentVector(const CostMatrix& cost_matrix,
+                                           const Solution& solution,
+                                           Eigen::VectorXi& assignment_vector) const {
+  assignment_vector.setConstant(cost_matrix.cols(), NO_ASSIGNMENT);
+  for (int row = 0; row < rows_; ++row) {
+    int column = solution.row_to_column[row];
+    int tracker = transposed_ ? column : row;
+    int measurement = transposed_ ? row : column;
+    if (cost_matrix(tracker, measurement) <= max_allowed_cost_) {
+      assignment_vector(measurement) = tracker;
+    }
+  }
+}
+}  // namespace data_association
+}  // namespace laser_object_tracker
@@ -37,7 +37,7 @@ namespace laser_object_tracker {
 namespace data_association {
 NaiveLinearAssignment::NaiveLinearAssignment(double max_allowed_cost) : BaseDataAssociation(max_allowed_cost) {}
 
-double NaiveLinearAssignment::solve(const Eigen::MatrixXd& cost_matrix,
+double NaiveLinearAssignment::solve(const CostMatrix& cost_matrix,
                                     const Eigen::MatrixXd& covariance_matrix,
                                     Eigen::VectorXi& assignment_vector) {
   assignment_vector.setConstant(cost_matrix.cols(), NO_ASSIGNMENT);
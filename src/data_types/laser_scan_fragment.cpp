@@ -33,6 +33,10 @@
 
 #include "laser_object_tracker/data_types/laser_scan_fragment.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
 // ROS
 #include <pcl_conversions/pcl_conversions.h>
 
@@ -62,6 +66,8 @@ void LaserScanFragment::LaserScanFragmentFactory::completeInitialization(LaserSc
     return;
   }
 
+  region_of_interest_.apply(fragment.laser_scan_);
+
   sensor_msgs::PointCloud2 pcl2;
   laser_projector_.projectLaser(fragment.laser_scan_, pcl2);
   pcl::moveFromROSMsg(pcl2, fragment.laser_scan_cloud_);
@@ -84,14 +90,20 @@ void LaserScanFragment::LaserScanFragmentFactory::completeInitialization(LaserSc
 LaserScanFragment::LaserScanFragment(const LaserScanFragment& other) noexcept :
     laser_scan_(other.laser_scan_),
     occlusion_vector_(other.occlusion_vector_),
-    laser_scan_cloud_(other.laser_scan_cloud_) {
+    laser_scan_cloud_(other.laser_scan_cloud_),
+    angles_(other.angles_),
+    descriptor_(other.descriptor_),
+    descriptor_computed_(other.descriptor_computed_) {
   initializeInternalContainer();
 }
 
 LaserScanFragment::LaserScanFragment(LaserScanFragment&& other) noexcept :
     laser_scan_(std::move(other.laser_scan_)),
     occlusion_vector_(std::move(other.occlusion_vector_)),
-    laser_scan_cloud_(std::move(other.laser_scan_cloud_)) {
+    laser_scan_cloud_(std::move(other.laser_scan_cloud_)),
+    angles_(std::move(other.angles_)),
+    descriptor_(other.descriptor_),
+    descriptor_computed_(other.descriptor_computed_) {
   initializeInternalContainer();
 }
 
@@ -99,6 +111,9 @@ LaserScanFragment& LaserScanFragment::operator=(const LaserScanFragment& other)
   laser_scan_ = other.laser_scan_;
   occlusion_vector_ = other.occlusion_vector_;
   laser_scan_cloud_ = other.laser_scan_cloud_;
+  angles_ = other.angles_;
+  descriptor_ = other.descriptor_;
+  descriptor_computed_ = other.descriptor_computed_;
 
   initializeInternalContainer();
 
@@ -109,13 +124,24 @@ LaserScanFragment& LaserScanFragment::operator=(LaserScanFragment&& other) noexc
   laser_scan_ = std::move(other.laser_scan_);
   occlusion_vector_ = std::move(other.occlusion_vector_);
   laser_scan_cloud_ = std::move(other.laser_scan_cloud_);
+  angles_ = std::move(other.angles_);
+  descriptor_ = other.descriptor_;
+  descriptor_computed_ = other.descriptor_computed_;
 
   initializeInternalContainer();
 
   return *this;
 }
 
-LaserScanFragment::LaserScanFragment(const LaserScanFragment& other, long first, long last) {
+LaserScanFragment::LaserScanFragment(const LaserScanFragment& other, long first, long last) :
+    LaserScanFragment(other, first, last, SegmentDescriptor()) {
+  computeSegmentDescriptor(laser_scan_cloud_, descriptor_);
+}
+
+LaserScanFragment::LaserScanFragment(const LaserScanFragment& other, long first, long last,
+                                     const SegmentDescriptor& descriptor) :
+    descriptor_(descriptor),
+    descriptor_computed_(true) {
   if (first < 0 || first >= other.size()) {
     throw std::out_of_range("First index out of range. Index: " + std::to_string(first) +
         ". Container size: " + std::to_string(other.size()));
@@ -130,8 +156,14 @@ LaserScanFragment::LaserScanFragment(const LaserScanFragment& other, long first,
   }
 
   laser_scan_.header = other.getHeader();
-  laser_scan_.angle_min = other.getAngleMin() + first * other.getAngleIncrement();
-  laser_scan_.angle_max = other.getAngleMin() + (last - 1) * other.getAngleIncrement();
+  if (other.hasEvenlySpacedAngles()) {
+    laser_scan_.angle_min = other.getAngleMin() + first * other.getAngleIncrement();
+    laser_scan_.angle_max = other.getAngleMin() + (last - 1) * other.getAngleIncrement();
+  } else {
+    angles_.assign(other.angles_.begin() + first, other.angles_.begin() + last);
+    laser_scan_.angle_min = angles_.front();
+    laser_scan_.angle_max = angles_.back();
+  }
   laser_scan_.angle_increment = other.getAngleIncrement();
   laser_scan_.range_min = other.getRangeMin();
   laser_scan_.range_max = other.getRangeMax();
@@ -156,6 +188,107 @@ LaserScanFragment::LaserScanFragment(const LaserScanFragment& other, long first,
   initializeInternalContainer();
 }
 
+LaserScanFragment::LaserScanFragment(const LaserScanFragment& first, const LaserScanFragment& second) :
+    laser_scan_(first.laser_scan_),
+    occlusion_vector_(first.occlusion_vector_),
+    laser_scan_cloud_(first.laser_scan_cloud_),
+    angles_(first.angles_) {
+  laser_scan_.ranges.insert(laser_scan_.ranges.end(),
+                            second.laser_scan_.ranges.begin(),
+                            second.laser_scan_.ranges.end());
+  if (first.hasEvenlySpacedAngles() && second.hasEvenlySpacedAngles()) {
+    laser_scan_.angle_max = laser_scan_.angle_min + (laser_scan_.ranges.size() - 1) * laser_scan_.angle_increment;
+  } else {
+    // Elements of the second one are shifted as a whole, so that its first one follows the last one of the first
+    if (angles_.empty()) {
+      angles_.reserve(laser_scan_.ranges.size());
+      std::transform(first.cbegin(), first.cend(), std::back_inserter(angles_), [](const auto& element) {
+        return element.getAngle();
+      });
+    }
+    const double offset = first.back().getAngle() + laser_scan_.angle_increment - second.front().getAngle();
+    std::transform(second.cbegin(), second.cend(), std::back_inserter(angles_), [offset](const auto& element) {
+      return element.getAngle() + offset;
+    });
+    laser_scan_.angle_max = angles_.back();
+  }
+
+  occlusion_vector_.insert(occlusion_vector_.end(),
+                           second.occlusion_vector_.begin(),
+                           second.occlusion_vector_.end());
+
+  laser_scan_cloud_.insert(laser_scan_cloud_.end(),
+                           second.laser_scan_cloud_.begin(),
+                           second.laser_scan_cloud_.end());
+
+  initializeInternalContainer();
+
+  computeSegmentDescriptor(laser_scan_cloud_, descriptor_);
+  descriptor_computed_ = true;
+}
+
+LaserScanFragment::LaserScanFragment(const std::vector<const LaserScanFragment*>& fragments) {
+  if (fragments.empty()) {
+    throw std::invalid_argument("At least one fragment is needed to be joined.");
+  }
+
+  const LaserScanFragment& prototype = *fragments.front();
+  laser_scan_.header = prototype.getHeader();
+  laser_scan_.angle_increment = prototype.getAngleIncrement();
+  laser_scan_.range_min = prototype.getRangeMin();
+  laser_scan_.range_max = prototype.getRangeMax();
+  laser_scan_.time_increment = prototype.laser_scan_.time_increment;
+  laser_scan_.scan_time = prototype.laser_scan_.scan_time;
+
+  laser_scan_cloud_.header = prototype.laser_scan_cloud_.header;
+  laser_scan_cloud_.is_dense = prototype.laser_scan_cloud_.is_dense;
+  laser_scan_cloud_.sensor_origin_ = prototype.laser_scan_cloud_.sensor_origin_;
+  laser_scan_cloud_.sensor_orientation_ = prototype.laser_scan_cloud_.sensor_orientation_;
+
+  long size = 0;
+  bool evenly_spaced = prototype.hasEvenlySpacedAngles();
+  for (int i = 0; i < fragments.size(); ++i) {
+    size += fragments[i]->size();
+    if (i > 0) {
+      // Fragments separated by other beams are not neighbours
+      const double gap = fragments[i]->front().getAngle() - fragments[i - 1]->back().getAngle();
+      evenly_spaced = evenly_spaced && fragments[i]->hasEvenlySpacedAngles() &&
+          std::abs(gap - laser_scan_.angle_increment) <= 0.5 * std::abs(laser_scan_.angle_increment);
+    }
+  }
+
+  laser_scan_.ranges.reserve(size);
+  occlusion_vector_.reserve(size);
+  laser_scan_cloud_.reserve(size);
+  if (!evenly_spaced) {
+    angles_.reserve(size);
+  }
+  for (const LaserScanFragment* fragment : fragments) {
+    laser_scan_.ranges.insert(laser_scan_.ranges.end(),
+                              fragment->laser_scan_.ranges.begin(),
+                              fragment->laser_scan_.ranges.end());
+    occlusion_vector_.insert(occlusion_vector_.end(),
+                             fragment->occlusion_vector_.begin(),
+                             fragment->occlusion_vector_.end());
+    laser_scan_cloud_.insert(laser_scan_cloud_.end(),
+                             fragment->laser_scan_cloud_.begin(),
+                             fragment->laser_scan_cloud_.end());
+    if (!evenly_spaced) {
+      std::transform(fragment->cbegin(), fragment->cend(), std::back_inserter(angles_), [](const auto& element) {
+        return element.getAngle();
+      });
+    }
+  }
+
+  laser_scan_.angle_min = prototype.front().getAngle();
+  laser_scan_.angle_max = fragments.back()->back().getAngle();
+
+  initializeInternalContainer();
+
+  computeSegmentDescriptor(laser_scan_cloud_, descriptor_);
+  descriptor_computed_ = true;
+}
+
 LaserScanFragment::Iterator LaserScanFragment::begin() {
   return elements_.begin();
 }
@@ -210,13 +343,22 @@ bool LaserScanFragment::isValid() const {
   });
 }
 
+const SegmentDescriptor& LaserScanFragment::descriptor() const {
+  if (!descriptor_computed_) {
+    computeSegmentDescriptor(laser_scan_cloud_, descriptor_);
+    descriptor_computed_ = true;
+  }
+
+  return descriptor_;
+}
+
 void LaserScanFragment::initializeInternalContainer() {
   elements_.clear();
 
   elements_.reserve(laser_scan_.ranges.size());
   for (int i = 0; i < laser_scan_.ranges.size(); ++i) {
     elements_.push_back({
-                            laser_scan_.angle_min + i * laser_scan_.angle_increment,
+                            angles_.empty() ? laser_scan_.angle_min + i * laser_scan_.angle_increment : angles_[i],
                             laser_scan_.ranges[i],
                             occlusion_vector_[i],
                             laser_scan_cloud_[i],
@@ -225,5 +367,31 @@ void LaserScanFragment::initializeInternalContainer() {
                         });
   }
 }
+
+void flagOcclusions(std::vector<LaserScanFragment>& fragments, double max_angle_gap) {
+  if (fragments.empty()) {
+    return;
+  }
+
+  fragments.front().front().isOccluded() = true;
+
+  for (int i = 1; i < fragments.size(); ++i) {
+    auto& current_element = fragments.at(i).front();
+    auto& previous_element = fragments.at(i - 1).back();
+    if (current_element.getAngle() - previous_element.getAngle() > max_angle_gap) {
+      continue;
+    }
+
+    if (current_element.range() < previous_element.range()) {
+      current_element.isOccluded() = true;
+    }
+
+    if (current_element.range() > previous_element.range()) {
+      previous_element.isOccluded() = true;
+    }
+  }
+
+  fragments.back().back().isOccluded() = true;
+}
 }  // namespace data_types
 }  // namespace laser_object_tracker
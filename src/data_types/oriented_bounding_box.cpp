@@ -0,0 +1,258 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "laser_object_tracker/data_types/oriented_bounding_box.hpp"
+
+// STD
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace laser_object_tracker {
+namespace data_types {
+
+namespace {
+/**
+ * @brief Differences of coordinates of a scan and their products are exact in double, so the sign is exact as well and
+ * collinear points, such as those of a straight wall, are not misclassified.
+ * @return Positive value if c lies to the left of line going from a to b, negative if it lies to the right
+ */
+inline double orientation(float a_x, float a_y, float b_x, float b_y, float c_x, float c_y) {
+  return (static_cast<double>(b_x) - a_x) * (static_cast<double>(c_y) - a_y) -
+      (static_cast<double>(b_y) - a_y) * (static_cast<double>(c_x) - a_x);
+}
+}  // namespace
+
+void OrientedBoundingBoxCalculator::clear() {
+  x_.clear();
+  y_.clear();
+}
+
+void OrientedBoundingBoxCalculator::addPoint(float x, float y) {
+  x_.push_back(x);
+  y_.push_back(y);
+}
+
+void OrientedBoundingBoxCalculator::compute(OrientedBoundingBox& obb) {
+  obb = OrientedBoundingBox();
+  if (x_.empty()) {
+    return;
+  }
+
+  long hull_begin, hull_size;
+  if (buildHull(hull_begin, hull_size)) {
+    rotatingCalipers(hull_begin, hull_size, obb);
+  } else {
+    computeCollinear(obb);
+  }
+}
+
+bool OrientedBoundingBoxCalculator::buildHull(long& hull_begin, long& hull_size) {
+  const long size = x_.size();
+
+  long second = 1;
+  while (second < size && x_[second] == x_[0] && y_[second] == y_[0]) {
+    ++second;
+  }
+  long third = second + 1;
+  while (third < size && orientation(x_[0], y_[0], x_[second], y_[second], x_[third], y_[third]) == 0.0) {
+    ++third;
+  }
+  if (third >= size) {
+    return false;
+  }
+
+  // Points before the third one lie on a single line, only its two extremes can belong to the hull
+  const double direction_x = static_cast<double>(x_[second]) - x_[0];
+  const double direction_y = static_cast<double>(y_[second]) - y_[0];
+  long first = 0, last = 0;
+  double min_projection = 0.0, max_projection = 0.0;
+  for (long i = 1; i < third; ++i) {
+    double projection = (static_cast<double>(x_[i]) - x_[0]) * direction_x +
+        (static_cast<double>(y_[i]) - y_[0]) * direction_y;
+    if (projection < min_projection) {
+      min_projection = projection;
+      first = i;
+    } else if (projection > max_projection) {
+      max_projection = projection;
+      last = i;
+    }
+  }
+
+  // Deque grows by at most one element on each side per point
+  if (hull_x_.size() < 2 * size + 4) {
+    hull_x_.resize(2 * size + 4);
+    hull_y_.resize(2 * size + 4);
+  }
+  float* hull_x = hull_x_.data();
+  float* hull_y = hull_y_.data();
+
+  long bottom = size, top = size + 3;
+  if (orientation(x_[first], y_[first], x_[last], y_[last], x_[third], y_[third]) < 0.0) {
+    std::swap(first, last);
+  }
+  hull_x[bottom] = hull_x[top] = x_[third];
+  hull_y[bottom] = hull_y[top] = y_[third];
+  hull_x[bottom + 1] = x_[first];
+  hull_y[bottom + 1] = y_[first];
+  hull_x[bottom + 2] = x_[last];
+  hull_y[bottom + 2] = y_[last];
+
+  for (long i = third + 1; i < size; ++i) {
+    const float x = x_[i], y = y_[i];
+    if (orientation(hull_x[top - 1], hull_y[top - 1], hull_x[top], hull_y[top], x, y) > 0.0 &&
+        orientation(hull_x[bottom], hull_y[bottom], hull_x[bottom + 1], hull_y[bottom + 1], x, y) > 0.0) {
+      continue;
+    }
+
+    // Bounds on the deque size only matter for points which are not ordered by bearing
+    while (top - bottom > 1 &&
+        orientation(hull_x[bottom], hull_y[bottom], hull_x[bottom + 1], hull_y[bottom + 1], x, y) <= 0.0) {
+      ++bottom;
+    }
+    --bottom;
+    hull_x[bottom] = x;
+    hull_y[bottom] = y;
+
+    while (top - bottom > 1 &&
+        orientation(hull_x[top - 1], hull_y[top - 1], hull_x[top], hull_y[top], x, y) <= 0.0) {
+      --top;
+    }
+    ++top;
+    hull_x[top] = x;
+    hull_y[top] = y;
+  }
+
+  hull_begin = bottom;
+  hull_size = top - bottom;
+  return true;
+}
+
+void OrientedBoundingBoxCalculator::computeCollinear(OrientedBoundingBox& obb) const {
+  const long size = x_.size();
+
+  long farthest = 0;
+  float farthest_distance = 0.0f;
+  for (long i = 1; i < size; ++i) {
+    float distance = std::hypot(x_[i] - x_[0], y_[i] - y_[0]);
+    if (distance > farthest_distance) {
+      farthest_distance = distance;
+      farthest = i;
+    }
+  }
+
+  if (farthest == 0) {
+    obb.center << x_[0], y_[0];
+    return;
+  }
+
+  const float direction_x = (x_[farthest] - x_[0]) / farthest_distance;
+  const float direction_y = (y_[farthest] - y_[0]) / farthest_distance;
+  float min_projection = 0.0f, max_projection = 0.0f;
+  for (long i = 1; i < size; ++i) {
+    float projection = (x_[i] - x_[0]) * direction_x + (y_[i] - y_[0]) * direction_y;
+    min_projection = std::min(min_projection, projection);
+    max_projection = std::max(max_projection, projection);
+  }
+
+  const float middle = (min_projection + max_projection) / 2.0f;
+  obb.center << x_[0] + direction_x * middle, y_[0] + direction_y * middle;
+  obb.size << max_projection - min_projection, 0.0;
+  obb.angle = std::atan2(direction_y, direction_x);
+}
+
+void OrientedBoundingBoxCalculator::rotatingCalipers(long hull_begin, long hull_size, OrientedBoundingBox& obb) const {
+  const float* hull_x = hull_x_.data() + hull_begin;
+  const float* hull_y = hull_y_.data() + hull_begin;
+  auto next = [hull_size](long index) {
+    return index + 1 == hull_size ? 0 : index + 1;
+  };
+
+  // Calipers touch the hull at the points of maximal projection along the edge, maximal distance from the edge and
+  // minimal projection along the edge. All of them only move forward as the edge goes around the hull.
+  long max_projection = 1, max_distance = 1, min_projection = 1;
+  double best_area = std::numeric_limits<double>::infinity();
+  for (long i = 0; i < hull_size; ++i) {
+    const long i_next = next(i);
+    double direction_x = static_cast<double>(hull_x[i_next]) - hull_x[i];
+    double direction_y = static_cast<double>(hull_y[i_next]) - hull_y[i];
+    const double length = std::hypot(direction_x, direction_y);
+    if (length == 0.0) {
+      continue;
+    }
+    direction_x /= length;
+    direction_y /= length;
+
+    auto projection = [&](long index) {
+      return (static_cast<double>(hull_x[index]) - hull_x[i]) * direction_x +
+          (static_cast<double>(hull_y[index]) - hull_y[i]) * direction_y;
+    };
+    auto distance = [&](long index) {
+      return (static_cast<double>(hull_y[index]) - hull_y[i]) * direction_x -
+          (static_cast<double>(hull_x[index]) - hull_x[i]) * direction_y;
+    };
+
+    if (i == 0) {
+      max_projection = i_next;
+    }
+    while (projection(next(max_projection)) > projection(max_projection)) {
+      max_projection = next(max_projection);
+    }
+    if (i == 0) {
+      max_distance = max_projection;
+    }
+    while (distance(next(max_distance)) > distance(max_distance)) {
+      max_distance = next(max_distance);
+    }
+    if (i == 0) {
+      min_projection = max_distance;
+    }
+    while (projection(next(min_projection)) < projection(min_projection)) {
+      min_projection = next(min_projection);
+    }
+
+    const double low = projection(min_projection), high = projection(max_projection);
+    const double width = high - low, height = distance(max_distance);
+    if (width * height < best_area) {
+      best_area = width * height;
+
+      const double middle = (low + high) / 2.0, half_height = height / 2.0;
+      obb.center << hull_x[i] + direction_x * middle - direction_y * half_height,
+          hull_y[i] + direction_y * middle + direction_x * half_height;
+      obb.size << width, height;
+      obb.angle = std::atan2(direction_y, direction_x);
+    }
+  }
+}
+}  // namespace data_types
+}  // namespace laser_object_tracker
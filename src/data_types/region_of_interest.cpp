@@ -0,0 +1,141 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "laser_object_tracker/data_types/region_of_interest.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace laser_object_tracker {
+namespace data_types {
+
+void RegionOfInterest::addAngleWindow(double angle_min, double angle_max) {
+  if (angle_min > angle_max) {
+    throw std::invalid_argument("Angle min cannot be greater than angle max. Angle min: " +
+        std::to_string(angle_min) + ". Angle max: " + std::to_string(angle_max));
+  }
+
+  angle_windows_.emplace_back(angle_min, angle_max);
+}
+
+void RegionOfInterest::setRangeLimits(double min_range, double max_range) {
+  if (min_range < 0.0 || min_range > max_range) {
+    throw std::invalid_argument("Range limits need to satisfy 0 <= min range <= max range. Min range: " +
+        std::to_string(min_range) + ". Max range: " + std::to_string(max_range));
+  }
+
+  min_range_ = min_range;
+  max_range_ = max_range;
+}
+
+void RegionOfInterest::setPolygon(const Polygon& polygon) {
+  if (!polygon.empty() && polygon.size() < 3) {
+    throw std::invalid_argument("Polygon needs at least 3 vertices. Vertices: " + std::to_string(polygon.size()));
+  }
+
+  polygon_ = polygon;
+}
+
+long RegionOfInterest::apply(LaserScanType& laser_scan) const {
+  if (isUnbounded()) {
+    return laser_scan.ranges.size();
+  }
+
+  long kept = 0;
+  for (long i = 0; i < laser_scan.ranges.size(); ++i) {
+    float& range = laser_scan.ranges[i];
+    // Returns which are already invalid keep their values, so that they are flagged as before
+    if (!(range >= laser_scan.range_min && range < laser_scan.range_max)) {
+      continue;
+    }
+
+    double angle = laser_scan.angle_min + i * laser_scan.angle_increment;
+
+    // Cheapest tests first, point is computed only for beams which passed the others
+    bool contained = containsAngle(angle) &&
+        containsRange(range) &&
+        (polygon_.empty() || containsPoint(Eigen::Vector2d(range * std::cos(angle), range * std::sin(angle))));
+    if (contained) {
+      ++kept;
+    } else {
+      range = std::numeric_limits<float>::infinity();
+    }
+  }
+
+  return kept;
+}
+
+bool RegionOfInterest::containsAngle(double angle) const {
+  if (angle_windows_.empty()) {
+    return true;
+  }
+
+  for (const auto& window : angle_windows_) {
+    if (angle >= window.first && angle <= window.second) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool RegionOfInterest::containsRange(double range) const {
+  return range >= min_range_ && range <= max_range_;
+}
+
+bool RegionOfInterest::containsPoint(const Eigen::Vector2d& point) const {
+  if (polygon_.empty()) {
+    return true;
+  }
+
+  // Even-odd rule, counts crossings of a ray cast from the point along x axis
+  bool inside = false;
+  for (size_t i = 0, j = polygon_.size() - 1; i < polygon_.size(); j = i++) {
+    const Eigen::Vector2d& a = polygon_[i];
+    const Eigen::Vector2d& b = polygon_[j];
+    if ((a.y() > point.y()) != (b.y() > point.y()) &&
+        point.x() < (b.x() - a.x()) * (point.y() - a.y()) / (b.y() - a.y()) + a.x()) {
+      inside = !inside;
+    }
+  }
+
+  return inside;
+}
+
+bool RegionOfInterest::isUnbounded() const {
+  return angle_windows_.empty() && polygon_.empty() &&
+      min_range_ <= 0.0 && max_range_ == std::numeric_limits<double>::infinity();
+}
+}  // namespace data_types
+}  // namespace laser_object_tracker
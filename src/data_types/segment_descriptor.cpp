@@ -0,0 +1,111 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "laser_object_tracker/data_types/segment_descriptor.hpp"
+
+// STD
+#include <cmath>
+
+namespace laser_object_tracker {
+namespace data_types {
+
+void SegmentDescriptorAccumulator::clear() {
+  points_number_ = 0;
+  sum_x_ = sum_y_ = sum_xx_ = sum_xy_ = sum_yy_ = 0.0;
+  obb_calculator_.clear();
+}
+
+void SegmentDescriptorAccumulator::add(const PointCloudType::PointType& point) {
+  if (!std::isfinite(point.x) || !std::isfinite(point.y)) {
+    return;
+  }
+
+  if (points_number_ == 0) {
+    reference_x_ = min_x_ = max_x_ = point.x;
+    reference_y_ = min_y_ = max_y_ = point.y;
+  }
+  ++points_number_;
+
+  double dx = point.x - reference_x_, dy = point.y - reference_y_;
+  sum_x_ += dx;
+  sum_y_ += dy;
+  sum_xx_ += dx * dx;
+  sum_xy_ += dx * dy;
+  sum_yy_ += dy * dy;
+
+  min_x_ = std::min<double>(min_x_, point.x);
+  min_y_ = std::min<double>(min_y_, point.y);
+  max_x_ = std::max<double>(max_x_, point.x);
+  max_y_ = std::max<double>(max_y_, point.y);
+
+  last_x_ = point.x;
+  last_y_ = point.y;
+
+  obb_calculator_.addPoint(point.x, point.y);
+}
+
+void SegmentDescriptorAccumulator::compute(SegmentDescriptor& descriptor) {
+  descriptor = SegmentDescriptor();
+  if (points_number_ == 0) {
+    return;
+  }
+
+  descriptor.points_number = points_number_;
+  double n = points_number_;
+  double mean_x = sum_x_ / n, mean_y = sum_y_ / n;
+  descriptor.centroid << reference_x_ + mean_x, reference_y_ + mean_y;
+  descriptor.covariance << sum_xx_ / n - mean_x * mean_x, sum_xy_ / n - mean_x * mean_y,
+      sum_xy_ / n - mean_x * mean_y, sum_yy_ / n - mean_y * mean_y;
+  descriptor.min << min_x_, min_y_;
+  descriptor.max << max_x_, max_y_;
+  descriptor.extent = std::hypot(last_x_ - reference_x_, last_y_ - reference_y_);
+
+  obb_calculator_.compute(descriptor.obb);
+}
+
+void computeSegmentDescriptor(const PointCloudType& points, SegmentDescriptor& descriptor,
+                              SegmentDescriptorAccumulator& accumulator) {
+  accumulator.clear();
+  for (const auto& point : points) {
+    accumulator.add(point);
+  }
+
+  accumulator.compute(descriptor);
+}
+
+void computeSegmentDescriptor(const PointCloudType& points, SegmentDescriptor& descriptor) {
+  thread_local SegmentDescriptorAccumulator accumulator;
+  computeSegmentDescriptor(points, descriptor, accumulator);
+}
+}  // namespace data_types
+}  // namespace laser_object_tracker
@@ -0,0 +1,208 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "laser_object_tracker/feature_extraction/cross2d_distance_kernel.hpp"
+
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define LASER_OBJECT_TRACKER_CROSS2D_AVX2
+#endif
+
+namespace laser_object_tracker {
+namespace feature_extraction {
+namespace {
+
+// Fused multiply-add is not used by any variant, so that vectorized and scalar results are bit-exact
+inline float squaredDistance(const Cross2DCoefficients& coefficients, float x, float y) {
+  float dx = x - coefficients(0);
+  float dy = y - coefficients(1);
+  float first = dy * coefficients(2) - dx * coefficients(3);
+  float second = dx * coefficients(2) + dy * coefficients(3);
+  return std::min(first * first, second * second);
+}
+
+void computeSquaredDistancesScalar(const Cross2DCoefficients& coefficients, const float* x, const float* y, int count,
+                                   float* squared_distances) {
+  for (int i = 0; i < count; ++i) {
+    squared_distances[i] = squaredDistance(coefficients, x[i], y[i]);
+  }
+}
+
+int countWithinDistanceScalar(const Cross2DCoefficients& coefficients, const float* x, const float* y, int count,
+                              float squared_threshold) {
+  int inliers = 0;
+  for (int i = 0; i < count; ++i) {
+    inliers += squaredDistance(coefficients, x[i], y[i]) < squared_threshold;
+  }
+  return inliers;
+}
+
+int selectWithinDistanceScalar(const Cross2DCoefficients& coefficients, const float* x, const float* y, int count,
+                               float squared_threshold, int* selected, float* squared_distances, int offset = 0) {
+  int selected_number = 0;
+  for (int i = 0; i < count; ++i) {
+    float squared_distance = squaredDistance(coefficients, x[i], y[i]);
+    if (squared_distance < squared_threshold) {
+      selected[selected_number] = offset + i;
+      squared_distances[selected_number] = squared_distance;
+      ++selected_number;
+    }
+  }
+  return selected_number;
+}
+
+#ifdef LASER_OBJECT_TRACKER_CROSS2D_AVX2
+struct Avx2Corner {
+  __m256 x, y, dx, dy;
+};
+
+__attribute__((target("avx2")))
+inline Avx2Corner loadCorner(const Cross2DCoefficients& coefficients) {
+  return {_mm256_set1_ps(coefficients(0)), _mm256_set1_ps(coefficients(1)),
+          _mm256_set1_ps(coefficients(2)), _mm256_set1_ps(coefficients(3))};
+}
+
+__attribute__((target("avx2")))
+inline __m256 squaredDistance(const Avx2Corner& corner, const float* x, const float* y) {
+  __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x), corner.x);
+  __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y), corner.y);
+  __m256 first = _mm256_sub_ps(_mm256_mul_ps(dy, corner.dx), _mm256_mul_ps(dx, corner.dy));
+  __m256 second = _mm256_add_ps(_mm256_mul_ps(dx, corner.dx), _mm256_mul_ps(dy, corner.dy));
+  return _mm256_min_ps(_mm256_mul_ps(first, first), _mm256_mul_ps(second, second));
+}
+
+__attribute__((target("avx2")))
+void computeSquaredDistancesAvx2(const Cross2DCoefficients& coefficients, const float* x, const float* y, int count,
+                                 float* squared_distances) {
+  Avx2Corner corner = loadCorner(coefficients);
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    _mm256_storeu_ps(squared_distances + i, squaredDistance(corner, x + i, y + i));
+  }
+  computeSquaredDistancesScalar(coefficients, x + i, y + i, count - i, squared_distances + i);
+}
+
+__attribute__((target("avx2,popcnt")))
+int countWithinDistanceAvx2(const Cross2DCoefficients& coefficients, const float* x, const float* y, int count,
+                            float squared_threshold) {
+  Avx2Corner corner = loadCorner(coefficients);
+  __m256 threshold = _mm256_set1_ps(squared_threshold);
+  int inliers = 0;
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 inlier = _mm256_cmp_ps(squaredDistance(corner, x + i, y + i), threshold, _CMP_LT_OQ);
+    inliers += _mm_popcnt_u32(_mm256_movemask_ps(inlier));
+  }
+  return inliers + countWithinDistanceScalar(coefficients, x + i, y + i, count - i, squared_threshold);
+}
+
+__attribute__((target("avx2")))
+int selectWithinDistanceAvx2(const Cross2DCoefficients& coefficients, const float* x, const float* y, int count,
+                             float squared_threshold, int* selected, float* squared_distances) {
+  Avx2Corner corner = loadCorner(coefficients);
+  __m256 threshold = _mm256_set1_ps(squared_threshold);
+  alignas(32) float block[8];
+  int selected_number = 0;
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 distances = squaredDistance(corner, x + i, y + i);
+    int mask = _mm256_movemask_ps(_mm256_cmp_ps(distances, threshold, _CMP_LT_OQ));
+    if (mask == 0) {
+      continue;
+    }
+
+    _mm256_store_ps(block, distances);
+    for (; mask != 0; mask &= mask - 1) {
+      int lane = __builtin_ctz(mask);
+      selected[selected_number] = i + lane;
+      squared_distances[selected_number] = block[lane];
+      ++selected_number;
+    }
+  }
+  return selected_number + selectWithinDistanceScalar(coefficients, x + i, y + i, count - i, squared_threshold,
+                                                      selected + selected_number, squared_distances + selected_number,
+                                                      i);
+}
+
+bool avx2Supported() {
+  static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+  return supported;
+}
+#endif
+}  // namespace
+
+void computeCross2DSquaredDistances(const Cross2DCoefficients& coefficients,
+                                    const float* x,
+                                    const float* y,
+                                    int count,
+                                    float* squared_distances) {
+#ifdef LASER_OBJECT_TRACKER_CROSS2D_AVX2
+  if (avx2Supported()) {
+    computeSquaredDistancesAvx2(coefficients, x, y, count, squared_distances);
+    return;
+  }
+#endif
+  computeSquaredDistancesScalar(coefficients, x, y, count, squared_distances);
+}
+
+int countCross2DWithinDistance(const Cross2DCoefficients& coefficients,
+                               const float* x,
+                               const float* y,
+                               int count,
+                               float squared_threshold) {
+#ifdef LASER_OBJECT_TRACKER_CROSS2D_AVX2
+  if (avx2Supported()) {
+    return countWithinDistanceAvx2(coefficients, x, y, count, squared_threshold);
+  }
+#endif
+  return countWithinDistanceScalar(coefficients, x, y, count, squared_threshold);
+}
+
+int selectCross2DWithinDistance(const Cross2DCoefficients& coefficients,
+                                const float* x,
+                                const float* y,
+                                int count,
+                                float squared_threshold,
+                                int* selected,
+                                float* squared_distances) {
+#ifdef LASER_OBJECT_TRACKER_CROSS2D_AVX2
+  if (avx2Supported()) {
+    return selectWithinDistanceAvx2(coefficients, x, y, count, squared_threshold, selected, squared_distances);
+  }
+#endif
+  return selectWithinDistanceScalar(coefficients, x, y, count, squared_threshold, selected, squared_distances);
+}
+}  // namespace feature_extraction
+}  // namespace laser_object_tracker
@@ -0,0 +1,149 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "laser_object_tracker/feature_extraction/incremental_segment_detection.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace laser_object_tracker {
+namespace feature_extraction {
+
+IncrementalSegmentDetection::IncrementalSegmentDetection(double distance_threshold, int min_points) {
+  setDistanceThreshold(distance_threshold);
+  setMinPoints(min_points);
+}
+
+bool IncrementalSegmentDetection::extractFeature(const data_types::LaserScanFragment& fragment,
+                                                 Eigen::VectorXd& feature) {
+  if (!extractSegments(fragment, segments_)) {
+    return false;
+  }
+
+  feature.resize(4 * segments_.size());
+  for (int i = 0; i < segments_.size(); ++i) {
+    feature.segment<2>(4 * i) = segments_.at(i).start_;
+    feature.segment<2>(4 * i + 2) = segments_.at(i).end_;
+  }
+
+  return true;
+}
+
+bool IncrementalSegmentDetection::extractSegments(const data_types::LaserScanFragment& fragment,
+                                                  features::Segments2D& segments) {
+  if (fragment.empty()) {
+    throw std::invalid_argument("Passed fragment is empty.");
+  }
+
+  PointsView points = fragmentPoints(fragment);
+  // Moments are accumulated relative to the first point, so that sums of squares do not lose precision
+  Eigen::Vector2d origin = points.col(0).cast<double>();
+
+  splitLines(points, origin);
+  mergeLines();
+
+  segments.clear();
+  for (const auto& line : lines_) {
+    if (line.moments.n < min_points_) {
+      continue;
+    }
+
+    Eigen::Hyperplane<double, 2> fitted_line = line.moments.line();
+    segments.emplace_back(fitted_line.projection(points.col(line.begin).cast<double>() - origin) + origin,
+                          fitted_line.projection(points.col(line.end - 1).cast<double>() - origin) + origin);
+  }
+
+  return !segments.empty();
+}
+
+double IncrementalSegmentDetection::getDistanceThreshold() const {
+  return distance_threshold_;
+}
+
+void IncrementalSegmentDetection::setDistanceThreshold(double distance_threshold) {
+  if (distance_threshold <= 0.0) {
+    throw std::invalid_argument("Distance threshold needs to be positive. Distance threshold: " +
+        std::to_string(distance_threshold));
+  }
+
+  distance_threshold_ = distance_threshold;
+}
+
+int IncrementalSegmentDetection::getMinPoints() const {
+  return min_points_;
+}
+
+void IncrementalSegmentDetection::setMinPoints(int min_points) {
+  if (min_points < 2) {
+    throw std::invalid_argument("Line needs at least 2 points. Min points: " + std::to_string(min_points));
+  }
+
+  min_points_ = min_points;
+}
+
+void IncrementalSegmentDetection::splitLines(const PointsView& points, const Eigen::Vector2d& origin) {
+  lines_.clear();
+
+  Line line{0, 0, LineMoments()};
+  for (int i = 0; i < points.cols(); ++i) {
+    Eigen::Vector2d point = points.col(i).cast<double>() - origin;
+    if (line.moments.n >= 2 && line.moments.line().absDistance(point) > distance_threshold_) {
+      line.end = i;
+      lines_.push_back(line);
+      line = Line{i, i, LineMoments()};
+    }
+
+    line.moments.add(point.x(), point.y());
+  }
+
+  line.end = points.cols();
+  lines_.push_back(line);
+}
+
+void IncrementalSegmentDetection::mergeLines() {
+  // Single pass, every line is merged into the last kept one or becomes the last kept one
+  int kept = 0;
+  for (int i = 1; i < lines_.size(); ++i) {
+    LineMoments joint = lines_.at(kept).moments + lines_.at(i).moments;
+    if (joint.residual() <= distance_threshold_ * distance_threshold_ * joint.n) {
+      lines_.at(kept).moments = joint;
+      lines_.at(kept).end = lines_.at(i).end;
+    } else {
+      lines_.at(++kept) = lines_.at(i);
+    }
+  }
+
+  lines_.resize(lines_.empty() ? 0 : kept + 1);
+}
+}  // namespace feature_extraction
+}  // namespace laser_object_tracker
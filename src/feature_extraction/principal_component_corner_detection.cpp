@@ -0,0 +1,126 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "laser_object_tracker/feature_extraction/principal_component_corner_detection.hpp"
+
+#include <limits>
+
+namespace laser_object_tracker {
+namespace feature_extraction {
+
+PrincipalComponentCornerDetection::PrincipalComponentCornerDetection(double min_arm_angle) {
+  setMinArmAngle(min_arm_angle);
+}
+
+bool PrincipalComponentCornerDetection::extractFeature(const data_types::LaserScanFragment& fragment,
+                                                       Eigen::VectorXd& feature) {
+  if (fragment.empty()) {
+    throw std::invalid_argument("Passed fragment is empty.");
+  }
+
+  PointsView points = fragmentPoints(fragment);
+  const int size = points.cols();
+
+  // Moments are accumulated relative to the centroid, so that sums of squares do not lose precision far from sensor
+  Eigen::Vector2d origin = points.cast<double>().rowwise().mean();
+  LineMoments total;
+  for (int i = 0; i < size; ++i) {
+    total.add(points(0, i) - origin.x(), points(1, i) - origin.y());
+  }
+
+  // Every point is assigned to both arms at most once, each split is assessed from running moments
+  double best_residual = std::numeric_limits<double>::infinity();
+  LineMoments first_arm, best_first_arm;
+  for (int split = 0; split < size - 2; ++split) {
+    first_arm.add(points(0, split) - origin.x(), points(1, split) - origin.y());
+    if (first_arm.n < 2) {
+      continue;
+    }
+
+    double residual = first_arm.residual() + (total - first_arm).residual();
+    if (residual < best_residual) {
+      best_residual = residual;
+      best_first_arm = first_arm;
+    }
+  }
+
+  Eigen::Vector2d first_point = points.col(0).cast<double>() - origin;
+  Eigen::Vector2d last_point = points.col(size - 1).cast<double>() - origin;
+
+  feature.resize(6);
+  Eigen::Hyperplane<double, 2> line_1, line_2;
+  if (best_first_arm.n >= 2) {
+    line_1 = best_first_arm.line();
+    line_2 = (total - best_first_arm).line();
+  }
+
+  if (best_first_arm.n >= 2 && std::abs(line_1.normal().dot(line_2.normal())) < std::cos(min_arm_angle_)) {
+    feature.head<2>() = line_1.intersection(line_2);
+    feature.segment<2>(2) = line_1.projection(first_point);
+    feature.tail<2>() = line_2.projection(last_point);
+  } else {
+    // Straight segment, or too few points to split it
+    line_1 = total.line();
+    feature.head<2>() = line_1.projection(first_point);
+    feature.segment<2>(2) = line_1.projection(last_point);
+    feature.tail<2>() = feature.head<2>();
+  }
+
+  feature.head<2>() += origin;
+  feature.segment<2>(2) += origin;
+  feature.tail<2>() += origin;
+
+  // Normal of any edge of an L-shape is one of its orientations
+  orientation_ = std::fmod(std::atan2(line_1.normal().y(), line_1.normal().x()) + 2.0 * M_PI, M_PI_2);
+
+  return true;
+}
+
+double PrincipalComponentCornerDetection::getMinArmAngle() const {
+  return min_arm_angle_;
+}
+
+void PrincipalComponentCornerDetection::setMinArmAngle(double min_arm_angle) {
+  if (min_arm_angle < 0.0 || min_arm_angle > M_PI_2) {
+    throw std::invalid_argument("Min arm angle needs to be in [0, pi/2]. Min arm angle: " +
+        std::to_string(min_arm_angle));
+  }
+
+  min_arm_angle_ = min_arm_angle;
+}
+
+double PrincipalComponentCornerDetection::getOrientation() const {
+  return orientation_;
+}
+}  // namespace feature_extraction
+}  // namespace laser_object_tracker
@@ -33,19 +33,13 @@
 
 #include "laser_object_tracker/feature_extraction/random_sample_consensus_segment_detection.hpp"
 
-#include <pcl/common/common.h>
-
 namespace laser_object_tracker {
 namespace feature_extraction {
 
 RandomSampleConsensusSegmentDetection::RandomSampleConsensusSegmentDetection(double distance_threshold,
                                                                              int max_iterations,
                                                                              double probability) :
-    sample_consensus_(ModelType::Ptr(nullptr), 0.0) {
-  sample_consensus_.setDistanceThreshold(distance_threshold);
-  sample_consensus_.setMaxIterations(max_iterations);
-  sample_consensus_.setProbability(probability);
-}
+    sample_consensus_(distance_threshold, max_iterations, probability) {}
 
 bool RandomSampleConsensusSegmentDetection::extractFeature(const data_types::LaserScanFragment& fragment,
                                                            Eigen::VectorXd& feature) {
@@ -53,34 +47,23 @@ bool RandomSampleConsensusSegmentDetection::extractFeature(const data_types::Las
     throw std::invalid_argument("Passed fragment is empty.");
   }
 
-  data_types::PointCloudType::ConstPtr point_cloud_ptr = fragment.pointCloud().makeShared();
-  if (sample_consensus_.getSampleConsensusModel()) {
-    sample_consensus_.getSampleConsensusModel()->setInputCloud(
-        data_types::PointCloudType::ConstPtr(point_cloud_ptr));
-  } else {
-    sample_consensus_.setSampleConsensusModel(ModelType::Ptr(
-        new ModelType(point_cloud_ptr, true)));
-  }
-
-  if (!sample_consensus_.computeModel()) {
+  if (!sample_consensus_.computeModel(fragmentPoints(fragment))) {
     return false;
   }
 
-  Eigen::VectorXf coefficients;
-  sample_consensus_.getModelCoefficients(coefficients);
+  const auto& coefficients = sample_consensus_.getModelCoefficients();
 
   Eigen::Hyperplane<double, 2> line = Eigen::Hyperplane<double, 2>::Through(
       Eigen::Vector2d(coefficients(0),
                       coefficients(1)),
-      Eigen::Vector2d(coefficients(0) + coefficients(3),
-                      coefficients(1) + coefficients(4)));
+      Eigen::Vector2d(coefficients(0) + coefficients(2),
+                      coefficients(1) + coefficients(3)));
 
-  PointType min, max;
-  pcl::getMinMax3D(*point_cloud_ptr, min, max);
+  const auto& descriptor = fragment.descriptor();
 
   feature.resize(4);
-  feature.template head<2>() = line.projection(Eigen::Vector2d(min.x, min.y));
-  feature.template tail<2>() = line.projection(Eigen::Vector2d(max.x, max.y));
+  feature.template head<2>() = line.projection(Eigen::Vector2d(descriptor.min));
+  feature.template tail<2>() = line.projection(Eigen::Vector2d(descriptor.max));
 
   return true;
 }
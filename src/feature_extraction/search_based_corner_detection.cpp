@@ -48,14 +48,71 @@ SearchBasedCornerDetection::extractFeature(const data_types::LaserScanFragment&
     throw std::invalid_argument("Passed fragment is empty.");
   }
 
-  double best_assessment = -std::numeric_limits<double>::infinity();
+  Eigen::MatrixX2d points;
+  fragmentToEigenMatrix(fragment, points);
+
   double best_angle = 0.0;
-  Eigen::Vector2d projection_1, projection_2;
+  searchOrientation(points, 0.0, M_PI_2, best_angle, assessment_);
+  buildFeature(points, best_angle, feature);
+
+  return true;
+}
+
+bool SearchBasedCornerDetection::extractFeature(const data_types::LaserScanFragment& fragment,
+                                                Eigen::VectorXd& feature,
+                                                double orientation_hint) {
+  if (fragment.empty()) {
+    throw std::invalid_argument("Passed fragment is empty.");
+  }
+
   Eigen::MatrixX2d points;
+  fragmentToEigenMatrix(fragment, points);
+
+  // Criteria do not change under rotation by pi/2, so the window may cross borders of [0, pi/2)
+  double best_angle = 0.0;
+  if (!searchOrientation(points, orientation_hint - hint_window_, orientation_hint + hint_window_,
+                         best_angle, assessment_) ||
+      assessment_ < min_hint_assessment_) {
+    searchOrientation(points, 0.0, M_PI_2, best_angle, assessment_);
+  }
+  buildFeature(points, best_angle, feature);
+
+  return true;
+}
+
+double SearchBasedCornerDetection::getOrientation() const {
+  return orientation_;
+}
+
+double SearchBasedCornerDetection::getAssessment() const {
+  return assessment_;
+}
+
+double SearchBasedCornerDetection::getHintWindow() const {
+  return hint_window_;
+}
+
+void SearchBasedCornerDetection::setHintWindow(double hint_window) {
+  hint_window_ = hint_window;
+}
+
+double SearchBasedCornerDetection::getMinHintAssessment() const {
+  return min_hint_assessment_;
+}
+
+void SearchBasedCornerDetection::setMinHintAssessment(double min_hint_assessment) {
+  min_hint_assessment_ = min_hint_assessment;
+}
+
+bool SearchBasedCornerDetection::searchOrientation(const Eigen::MatrixX2d& points, double from, double to,
+                                                   double& best_angle, double& best_assessment) const {
+  best_assessment = -std::numeric_limits<double>::infinity();
+  Eigen::Vector2d projection_1, projection_2;
   Eigen::VectorXd projected_points_x, projected_points_y;
 
-  fragmentToEigenMatrix(fragment, points);
-  for (double theta = 0; theta < M_PI_2; theta += theta_resolution_) {
+  int best_step = 0, step = 0;
+  best_angle = from;
+  for (double theta = from; theta < to; theta += theta_resolution_, ++step) {
     projection_1 << std::cos(theta), std::sin(theta);
     projection_2 << -std::sin(theta), std::cos(theta);
 
@@ -66,20 +123,26 @@ SearchBasedCornerDetection::extractFeature(const data_types::LaserScanFragment&
     if (assessment > best_assessment) {
       best_assessment = assessment;
       best_angle = theta;
+      best_step = step;
     }
   }
 
-  projection_1 << std::cos(best_angle), std::sin(best_angle);
-  projection_2 << -std::sin(best_angle), std::cos(best_angle);
+  return best_step != 0 && best_step != step - 1;
+}
+
+void SearchBasedCornerDetection::buildFeature(const Eigen::MatrixX2d& points, double angle, Eigen::VectorXd& feature) {
+  Eigen::Vector2d projection_1, projection_2;
+  projection_1 << std::cos(angle), std::sin(angle);
+  projection_2 << -std::sin(angle), std::cos(angle);
 
-  projected_points_x = points * projection_1;
-  projected_points_y = points * projection_2;
+  Eigen::VectorXd projected_points_x = points * projection_1;
+  Eigen::VectorXd projected_points_y = points * projection_2;
 
   Eigen::Hyperplane<double, 2> edge_1, edge_2, edge_3, edge_4;
-  edge_1.coeffs() << std::cos(best_angle), std::sin(best_angle), -projected_points_x.minCoeff();
-  edge_2.coeffs() << -std::sin(best_angle), std::cos(best_angle), -projected_points_y.minCoeff();
-  edge_3.coeffs() << std::cos(best_angle), std::sin(best_angle), -projected_points_x.maxCoeff();
-  edge_4.coeffs() << -std::sin(best_angle), std::cos(best_angle), -projected_points_y.maxCoeff();
+  edge_1.coeffs() << std::cos(angle), std::sin(angle), -projected_points_x.minCoeff();
+  edge_2.coeffs() << -std::sin(angle), std::cos(angle), -projected_points_y.minCoeff();
+  edge_3.coeffs() << std::cos(angle), std::sin(angle), -projected_points_x.maxCoeff();
+  edge_4.coeffs() << -std::sin(angle), std::cos(angle), -projected_points_y.maxCoeff();
 
   feature = findMatchingCorner(points.col(0), points.col(1),
                                edge_1,
@@ -87,7 +150,7 @@ SearchBasedCornerDetection::extractFeature(const data_types::LaserScanFragment&
                                edge_3,
                                edge_4);
 
-  return true;
+  orientation_ = angle - std::floor(angle / M_PI_2) * M_PI_2;
 }
 
 double SearchBasedCornerDetection::getThetaResolution() const {
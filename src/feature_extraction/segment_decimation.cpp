@@ -0,0 +1,131 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "laser_object_tracker/feature_extraction/segment_decimation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace laser_object_tracker {
+namespace feature_extraction {
+
+SegmentDecimation::SegmentDecimation(double min_spacing, double angular_spacing) {
+  setMinSpacing(min_spacing);
+  setAngularSpacing(angular_spacing);
+}
+
+long SegmentDecimation::decimate(const data_types::LaserScanFragment& fragment,
+                                 Eigen::Matrix2Xf& decimated_points) const {
+  const auto& points = fragment.pointCloud().points;
+  const long size = points.size();
+  if (decimated_points.cols() < size) {
+    decimated_points.resize(2, size);
+  }
+  if (size == 0) {
+    return 0;
+  }
+
+  // Extremes are found in the first pass, so that the second one keeps them in order with the other points
+  long min_x = 0, max_x = 0, min_y = 0, max_y = 0, farthest = 0;
+  Eigen::Vector2f first(points.front().x, points.front().y);
+  Eigen::Vector2f chord(points.back().x - first.x(), points.back().y - first.y());
+  float farthest_distance = -1.0f;
+  for (long i = 0; i < size; ++i) {
+    const auto& point = points[i];
+    min_x = point.x < points[min_x].x ? i : min_x;
+    max_x = point.x > points[max_x].x ? i : max_x;
+    min_y = point.y < points[min_y].y ? i : min_y;
+    max_y = point.y > points[max_y].y ? i : max_y;
+
+    // Distance scaled by the chord length, which does not change the farthest point
+    float distance = std::abs(chord.x() * (point.y - first.y()) - chord.y() * (point.x - first.x()));
+    if (distance > farthest_distance) {
+      farthest_distance = distance;
+      farthest = i;
+    }
+  }
+
+  long kept = 0;
+  float arc_length = 0.0f;
+  for (long i = 0; i < size; ++i) {
+    const auto& point = points[i];
+    if (i > 0) {
+      arc_length += std::hypot(point.x - points[i - 1].x, point.y - points[i - 1].y);
+    }
+
+    bool keep = i == 0 || i == size - 1 ||
+        i == min_x || i == max_x || i == min_y || i == max_y || i == farthest ||
+        arc_length >= getTargetSpacing(std::hypot(point.x, point.y));
+    if (keep) {
+      decimated_points(0, kept) = point.x;
+      decimated_points(1, kept) = point.y;
+      ++kept;
+      arc_length = 0.0f;
+    }
+  }
+
+  return kept;
+}
+
+double SegmentDecimation::getTargetSpacing(double range) const {
+  return std::max(min_spacing_, angular_spacing_ * range);
+}
+
+double SegmentDecimation::getMinSpacing() const {
+  return min_spacing_;
+}
+
+void SegmentDecimation::setMinSpacing(double min_spacing) {
+  if (min_spacing < 0.0) {
+    throw std::invalid_argument("Min spacing cannot be negative. Min spacing: " + std::to_string(min_spacing));
+  }
+
+  min_spacing_ = min_spacing;
+}
+
+double SegmentDecimation::getAngularSpacing() const {
+  return angular_spacing_;
+}
+
+void SegmentDecimation::setAngularSpacing(double angular_spacing) {
+  if (angular_spacing < 0.0) {
+    throw std::invalid_argument("Angular spacing cannot be negative. Angular spacing: " +
+        std::to_string(angular_spacing));
+  }
+
+  angular_spacing_ = angular_spacing;
+}
+}  // namespace feature_extraction
+}  // namespace laser_object_tracker
@@ -33,19 +33,139 @@
 
 #include "laser_object_tracker/filtering/aggregate_segmented_filtering.hpp"
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
 namespace laser_object_tracker {
 namespace filtering {
+double FilterStatistics::averageCost() const {
+  return timed_calls == 0.0 ? 0.0 : total_time.count() / timed_calls;
+}
+
+double FilterStatistics::rejectionRate() const {
+  return calls == 0.0 ? 0.0 : rejections / calls;
+}
+
+void FilterStatistics::decay(double factor) {
+  calls *= factor;
+  rejections *= factor;
+  timed_calls *= factor;
+  total_time *= factor;
+}
+
 AggregateSegmentedFiltering::AggregateSegmentedFiltering(
-    std::vector<std::unique_ptr<BaseSegmentedFiltering>>&& filters) : filters_(std::move(filters)) {}
+    std::vector<std::unique_ptr<BaseSegmentedFiltering>>&& filters, long reorder_period) :
+    filters_(std::move(filters)),
+    reorder_period_(reorder_period),
+    statistics_(filters_.size()),
+    order_(filters_.size()) {
+  std::iota(order_.begin(), order_.end(), 0);
+}
 
 bool AggregateSegmentedFiltering::shouldFilter(const data_types::LaserScanFragment& fragment) const {
-  return std::any_of(filters_.begin(),
-                     filters_.end(),
-                     [&fragment](const auto& filter) {return filter->shouldFilter(fragment);});
+  if (reorder_period_ > 0 && ++calls_since_reorder_ >= reorder_period_) {
+    reorder();
+    calls_since_reorder_ = 0;
+  }
+
+  // Reading the clock may cost as much as a cheap filter, so only a sample of calls is timed
+  const bool timed = calls_since_timing_ == 0;
+  calls_since_timing_ = (calls_since_timing_ + 1) % timing_period_;
+
+  for (size_t index : order_) {
+    auto& statistics = statistics_[index];
+    bool rejected;
+    if (timed) {
+      auto start = std::chrono::steady_clock::now();
+      rejected = filters_[index]->shouldFilter(fragment);
+      statistics.total_time += std::chrono::steady_clock::now() - start;
+      statistics.timed_calls += 1.0;
+    } else {
+      rejected = filters_[index]->shouldFilter(fragment);
+    }
+    statistics.calls += 1.0;
+
+    if (rejected) {
+      statistics.rejections += 1.0;
+      return true;
+    }
+  }
+
+  return false;
 }
 
 void AggregateSegmentedFiltering::add(std::unique_ptr<BaseSegmentedFiltering> filter) {
   filters_.push_back(std::move(filter));
+  statistics_.emplace_back();
+  order_.push_back(filters_.size() - 1);
+}
+
+const std::vector<FilterStatistics>& AggregateSegmentedFiltering::getStatistics() const {
+  return statistics_;
+}
+
+void AggregateSegmentedFiltering::resetStatistics() {
+  std::fill(statistics_.begin(), statistics_.end(), FilterStatistics());
+  calls_since_reorder_ = 0;
+  calls_since_timing_ = 0;
+}
+
+const std::vector<size_t>& AggregateSegmentedFiltering::getEvaluationOrder() const {
+  return order_;
+}
+
+long AggregateSegmentedFiltering::getReorderPeriod() const {
+  return reorder_period_;
+}
+
+void AggregateSegmentedFiltering::setReorderPeriod(long reorder_period) {
+  reorder_period_ = reorder_period;
+}
+
+long AggregateSegmentedFiltering::getTimingPeriod() const {
+  return timing_period_;
+}
+
+void AggregateSegmentedFiltering::setTimingPeriod(long timing_period) {
+  if (timing_period < 1) {
+    throw std::invalid_argument("Timing period needs to be positive. Timing period: " +
+        std::to_string(timing_period));
+  }
+
+  timing_period_ = timing_period;
+  calls_since_timing_ = 0;
+}
+
+double AggregateSegmentedFiltering::getStatisticsDecay() const {
+  return statistics_decay_;
+}
+
+void AggregateSegmentedFiltering::setStatisticsDecay(double statistics_decay) {
+  if (statistics_decay <= 0.0 || statistics_decay > 1.0) {
+    throw std::invalid_argument("Statistics decay needs to be in range (0, 1]. Statistics decay: " +
+        std::to_string(statistics_decay));
+  }
+
+  statistics_decay_ = statistics_decay;
+}
+
+void AggregateSegmentedFiltering::reorder() const {
+  auto expected_cost = [this](size_t index) {
+    const auto& statistics = statistics_[index];
+    return statistics.rejections == 0.0 ? std::numeric_limits<double>::infinity()
+                                      : statistics.averageCost() / statistics.rejectionRate();
+  };
+
+  std::stable_sort(order_.begin(), order_.end(), [&expected_cost](size_t lhs, size_t rhs) {
+    return expected_cost(lhs) < expected_cost(rhs);
+  });
+
+  for (auto& statistics : statistics_) {
+    statistics.decay(statistics_decay_);
+  }
 }
 }  // namespace filtering
 }  // namespace laser_object_tracker
@@ -37,10 +37,11 @@ namespace laser_object_tracker {
 namespace filtering {
 
 void BaseSegmentedFiltering::filter(std::vector<laser_object_tracker::data_types::LaserScanFragment>& fragments) const {
-  using std::placeholders::_1;
   fragments.erase(std::remove_if(fragments.begin(),
                                  fragments.end(),
-                                 std::bind(&BaseSegmentedFiltering::shouldFilter, this, _1)),
+                                 [this](const data_types::LaserScanFragment& fragment) {
+                                   return shouldFilter(fragment);
+                                 }),
                   fragments.end());
 }
 
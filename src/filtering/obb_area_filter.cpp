@@ -33,8 +33,6 @@
 
 #include "laser_object_tracker/filtering/obb_area_filter.hpp"
 
-#include <opencv2/imgproc/imgproc.hpp>
-
 namespace laser_object_tracker {
 namespace filtering {
 OBBAreaFilter::OBBAreaFilter(double min_area, double max_area, double min_box_dimension)
@@ -73,17 +71,9 @@ double OBBAreaFilter::getOBBArea(const data_types::LaserScanFragment& fragment)
   if (fragment.empty()) {
     return 0.0;
   }
-  std::vector<cv::Point2f> points(fragment.size());
-  for (int i = 0; i < fragment.size(); ++i) {
-    points.at(i).x = fragment.at(i).point().x;
-    points.at(i).y = fragment.at(i).point().y;
-  }
-  auto rectangle = cv::minAreaRect(points);
-
-  rectangle.size.height = std::max(static_cast<float>(min_box_dimension_), rectangle.size.height);
-  rectangle.size.width = std::max(static_cast<float>(min_box_dimension_), rectangle.size.width);
+  const auto& obb = fragment.descriptor().obb;
 
-  return rectangle.size.area();
+  return std::max(min_box_dimension_, obb.size(0)) * std::max(min_box_dimension_, obb.size(1));
 }
 }  // namespace filtering
 }  // namespace laser_object_tracker
@@ -42,25 +42,7 @@ bool OcclusionDetection::shouldFilter(const laser_object_tracker::data_types::La
 }
 
 void OcclusionDetection::filter(std::vector<data_types::LaserScanFragment>& fragments) const {
-  fragments.front().front().isOccluded() = true;
-
-  for (int i = 1; i < fragments.size(); ++i) {
-    auto& current_element = fragments.at(i).front();
-    auto& previous_element = fragments.at(i - 1).back();
-    if (current_element.getAngle() - previous_element.getAngle() > max_angle_gap_) {
-      continue;
-    }
-
-    if (current_element.range() < previous_element.range()) {
-      current_element.isOccluded() = true;
-    }
-
-    if (current_element.range() > previous_element.range()) {
-      previous_element.isOccluded() = true;
-    }
-  }
-
-  fragments.back().back().isOccluded() = true;
+  data_types::flagOcclusions(fragments, max_angle_gap_);
 }
 }  // namespace filtering
 }  // namespace laser_object_tracker
@@ -0,0 +1,172 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "laser_object_tracker/filtering/segment_merging.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace laser_object_tracker {
+namespace filtering {
+SegmentMerging::SegmentMerging(double max_gap_distance, int max_skipped_segments) {
+  setMaxGapDistance(max_gap_distance);
+  setMaxSkippedSegments(max_skipped_segments);
+}
+
+bool SegmentMerging::shouldFilter(const data_types::LaserScanFragment& fragment) const {
+  return false;
+}
+
+void SegmentMerging::filter(std::vector<data_types::LaserScanFragment>& fragments) const {
+  const int size = fragments.size();
+  parents_.resize(size);
+  std::iota(parents_.begin(), parents_.end(), 0);
+
+  bool any_merged = false;
+  for (int former = 0; former < size; ++former) {
+    for (int latter = former + 1; latter < size && latter <= former + max_skipped_segments_ + 1; ++latter) {
+      if (shouldMerge(fragments, former, latter)) {
+        unite(former, latter);
+        any_merged = true;
+      }
+    }
+  }
+
+  if (!any_merged) {
+    return;
+  }
+
+  // Every group is emitted at the position of its first member, members are collected in scan order and joined once
+  first_members_.assign(size, -1);
+  int groups_number = 0;
+  for (int index = 0; index < size; ++index) {
+    int& slot = first_members_.at(find(index));
+    if (slot < 0) {
+      slot = groups_number++;
+      if (groups_.size() < groups_number) {
+        groups_.emplace_back();
+      }
+      groups_.at(slot).clear();
+    }
+    groups_.at(slot).push_back(index);
+  }
+
+  merged_.clear();
+  merged_.reserve(groups_number);
+  for (int group = 0; group < groups_number; ++group) {
+    const auto& indices = groups_.at(group);
+    if (indices.size() == 1) {
+      merged_.push_back(std::move(fragments.at(indices.front())));
+    } else {
+      members_.clear();
+      for (int index : indices) {
+        members_.push_back(&fragments.at(index));
+      }
+      merged_.emplace_back(members_);
+    }
+  }
+
+  fragments.swap(merged_);
+}
+
+bool SegmentMerging::shouldMerge(const std::vector<data_types::LaserScanFragment>& fragments,
+                                 int former, int latter) const {
+  const auto& last = fragments.at(former).back();
+  const auto& first = fragments.at(latter).front();
+
+  if (latter > former + 1) {
+    // OcclusionDetection flags the closer of neighbouring ends, so segments bordering the gap need to be flagged
+    if (!fragments.at(former + 1).front().isOccluded() || !fragments.at(latter - 1).back().isOccluded()) {
+      return false;
+    }
+
+    const float range = std::min(last.range(), first.range());
+    for (int skipped = former + 1; skipped < latter; ++skipped) {
+      if (fragments.at(skipped).front().range() >= range || fragments.at(skipped).back().range() >= range) {
+        return false;
+      }
+    }
+  }
+
+  return std::hypot(first.point().x - last.point().x, first.point().y - last.point().y) <= max_gap_distance_;
+}
+
+double SegmentMerging::getMaxGapDistance() const {
+  return max_gap_distance_;
+}
+
+void SegmentMerging::setMaxGapDistance(double max_gap_distance) {
+  if (max_gap_distance < 0.0) {
+    throw std::invalid_argument("Max gap distance cannot be negative. Max gap distance: " +
+        std::to_string(max_gap_distance));
+  }
+
+  max_gap_distance_ = max_gap_distance;
+}
+
+int SegmentMerging::getMaxSkippedSegments() const {
+  return max_skipped_segments_;
+}
+
+void SegmentMerging::setMaxSkippedSegments(int max_skipped_segments) {
+  if (max_skipped_segments < 0) {
+    throw std::invalid_argument("Max skipped segments cannot be negative. Max skipped segments: " +
+        std::to_string(max_skipped_segments));
+  }
+
+  max_skipped_segments_ = max_skipped_segments;
+}
+
+int SegmentMerging::find(int index) const {
+  while (parents_.at(index) != index) {
+    // Path halving
+    parents_.at(index) = parents_.at(parents_.at(index));
+    index = parents_.at(index);
+  }
+
+  return index;
+}
+
+void SegmentMerging::unite(int lhs, int rhs) const {
+  lhs = find(lhs);
+  rhs = find(rhs);
+  // Lower index becomes the root, so roots are first members of their groups
+  if (lhs != rhs) {
+    parents_.at(std::max(lhs, rhs)) = std::min(lhs, rhs);
+  }
+}
+}  // namespace filtering
+}  // namespace laser_object_tracker
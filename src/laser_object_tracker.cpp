@@ -35,16 +35,36 @@
 #include "laser_object_tracker/data_types/data_types.hpp"
 #include "laser_object_tracker/feature_extraction/feature_extraction.hpp"
 #include "laser_object_tracker/filtering/filtering.hpp"
+#include "laser_object_tracker/pipeline_context.hpp"
 #include "laser_object_tracker/segmentation/segmentation.hpp"
 #include "laser_object_tracker/visualization/visualization.hpp"
 #include "laser_object_tracker/tracking/tracking.hpp"
 
 laser_object_tracker::data_types::LaserScanFragment::LaserScanFragmentFactory factory;
 laser_object_tracker::data_types::LaserScanFragment fragment;
+bool new_laser_scan = false;
+std::unique_ptr<laser_object_tracker::segmentation::BackgroundSubtraction> background_subtraction;
+std::string background_snapshot_path;
+int background_snapshot_period = 0;
+long scans_since_snapshot = 0;
 
 void laserScanCallback(const sensor_msgs::LaserScan::Ptr& laser_scan) {
   ROS_INFO("Received laser scan");
+  if (background_subtraction) {
+    long foreground = background_subtraction->apply(*laser_scan);
+    ROS_INFO("%ld foreground beams", foreground);
+
+    if (!background_snapshot_path.empty() && background_snapshot_period > 0 &&
+        ++scans_since_snapshot >= background_snapshot_period) {
+      scans_since_snapshot = 0;
+      // Model is copied here and written to disk on the writer thread of the model
+      if (!background_subtraction->saveAsync(background_snapshot_path)) {
+        ROS_WARN("Could not save background snapshot to %s", background_snapshot_path.c_str());
+      }
+    }
+  }
   fragment = factory.fromLaserScan(std::move(*laser_scan));
+  new_laser_scan = true;
 
   ROS_INFO("Fragment has %d elements.", fragment.size());
 }
@@ -55,23 +75,102 @@ std::shared_ptr<segmentation::BaseSegmentation> getSegmentation(ros::NodeHandle&
   std::shared_ptr<segmentation::BaseSegmentation> segmentation;
 
   std::string type;
+  int chunks = 1;
+  bool wrap_around = false;
   nh.getParam("segmentation/type", type);
+  nh.getParam("segmentation/chunks", chunks);
+  nh.getParam("segmentation/wrap_around", wrap_around);
+
+  // Occlusion flags needed by segment merging are set within the segmentation pass
+  bool merging = false;
+  double occlusion_angle_gap = 0.05;
+  nh.getParam("merging/enabled", merging);
+  nh.getParam("merging/max_angle_gap", occlusion_angle_gap);
+  if (!merging) {
+    occlusion_angle_gap = -1.0;
+  }
   if (type == "BreakpointDetection") {
     double threshold;
     nh.getParam("segmentation/threshold", threshold);
 
-    segmentation.reset(new segmentation::BreakpointDetection(threshold));
+    auto detection = std::make_shared<segmentation::BreakpointDetection>(threshold);
+    detection->setChunksNumber(chunks);
+    detection->setWrapAround(wrap_around);
+    detection->setOcclusionAngleGap(occlusion_angle_gap);
+    segmentation = detection;
   } else if (type == "AdaptiveThresholdDetection") {
     double angle, sigma;
     nh.getParam("segmentation/angle", angle);
     nh.getParam("segmentation/sigma", sigma);
 
-    segmentation.reset(new segmentation::AdaptiveBreakpointDetection(angle, sigma));
+    auto detection = std::make_shared<segmentation::AdaptiveBreakpointDetection>(angle, sigma);
+    detection->setChunksNumber(chunks);
+    detection->setWrapAround(wrap_around);
+    detection->setOcclusionAngleGap(occlusion_angle_gap);
+    segmentation = detection;
   }
 
   return segmentation;
 }
 
+std::unique_ptr<segmentation::BackgroundSubtraction> getBackgroundSubtraction(ros::NodeHandle& nh) {
+  bool enabled = false;
+  nh.getParam("background/enabled", enabled);
+  if (!enabled) {
+    return nullptr;
+  }
+
+  int history_size = 32, min_matches = 24, update_period = 10;
+  double distance_tolerance = 0.05;
+  nh.getParam("background/history_size", history_size);
+  nh.getParam("background/min_matches", min_matches);
+  nh.getParam("background/distance_tolerance", distance_tolerance);
+  nh.getParam("background/update_period", update_period);
+
+  auto background = std::make_unique<segmentation::BackgroundSubtraction>(history_size,
+                                                                         min_matches,
+                                                                         distance_tolerance,
+                                                                         update_period);
+
+  // Model restored from the last snapshot is used from the first scan, if it matches the scanner
+  nh.getParam("background/snapshot_path", background_snapshot_path);
+  nh.getParam("background/snapshot_period", background_snapshot_period);
+  if (!background_snapshot_path.empty()) {
+    if (background->load(background_snapshot_path)) {
+      ROS_INFO("Loaded background snapshot from %s", background_snapshot_path.c_str());
+    } else {
+      ROS_WARN("Could not load background snapshot from %s", background_snapshot_path.c_str());
+    }
+  }
+
+  return background;
+}
+
+data_types::RegionOfInterest getRegionOfInterest(ros::NodeHandle& nh) {
+  data_types::RegionOfInterest region_of_interest;
+
+  // Windows and polygon are given as flat lists, [min_1, max_1, min_2, max_2, ...] and [x_1, y_1, x_2, y_2, ...]
+  std::vector<double> angle_windows, polygon;
+  nh.getParam("roi/angle_windows", angle_windows);
+  nh.getParam("roi/polygon", polygon);
+  for (int i = 0; i + 1 < angle_windows.size(); i += 2) {
+    region_of_interest.addAngleWindow(angle_windows.at(i), angle_windows.at(i + 1));
+  }
+
+  data_types::RegionOfInterest::Polygon vertices;
+  for (int i = 0; i + 1 < polygon.size(); i += 2) {
+    vertices.emplace_back(polygon.at(i), polygon.at(i + 1));
+  }
+  region_of_interest.setPolygon(vertices);
+
+  double min_range = region_of_interest.getMinRange(), max_range = region_of_interest.getMaxRange();
+  nh.getParam("roi/min_range", min_range);
+  nh.getParam("roi/max_range", max_range);
+  region_of_interest.setRangeLimits(min_range, max_range);
+
+  return region_of_interest;
+}
+
 std::map<std::string, feature_extraction::SearchBasedCornerDetection::CriterionFunctor> getCriterions() {
   return {{"areaCriterion", feature_extraction::areaCriterion},
           {"closenessCriterion", feature_extraction::closenessCriterion},
@@ -82,37 +181,81 @@ std::shared_ptr<laser_object_tracker::filtering::BaseSegmentedFiltering> getFilt
   int min_points, max_points;
   nh.getParam("filtering/min_points", min_points);
   nh.getParam("filtering/max_points", max_points);
-  auto points = std::make_unique<laser_object_tracker::filtering::PointsNumberFilter>(min_points, max_points);
+  laser_object_tracker::filtering::PointsNumberFilter points_filter(min_points, max_points);
 
   double min_area, max_area, min_dimension;
   nh.getParam("filtering/min_area", min_area);
   nh.getParam("filtering/max_area", max_area);
   nh.getParam("filtering/min_dimension", min_dimension);
-  auto obb = std::make_unique<laser_object_tracker::filtering::OBBAreaFilter>(min_area, max_area, min_dimension);
+  laser_object_tracker::filtering::OBBAreaFilter obb_filter(min_area, max_area, min_dimension);
+
+  std::string type = "AggregateSegmentedFiltering";
+  nh.getParam("filtering/type", type);
+  if (type == "StaticFilterCascade") {
+    return std::make_shared<laser_object_tracker::filtering::StaticFilterCascade<
+        laser_object_tracker::filtering::PointsNumberFilter,
+        laser_object_tracker::filtering::OBBAreaFilter>>(points_filter, obb_filter);
+  }
+
+  auto points = std::make_unique<laser_object_tracker::filtering::PointsNumberFilter>(points_filter);
+  auto obb = std::make_unique<laser_object_tracker::filtering::OBBAreaFilter>(obb_filter);
 
   std::vector<std::unique_ptr<laser_object_tracker::filtering::BaseSegmentedFiltering>> filters;
   filters.push_back(std::move(points));
   filters.push_back(std::move(obb));
 
-  return std::make_unique<laser_object_tracker::filtering::AggregateSegmentedFiltering>(std::move(filters));
+  int reorder_period = 1000;
+  nh.getParam("filtering/reorder_period", reorder_period);
+
+  int timing_period = 16;
+  nh.getParam("filtering/timing_period", timing_period);
+  double statistics_decay = 0.5;
+  nh.getParam("filtering/statistics_decay", statistics_decay);
+
+  auto aggregate = std::make_unique<laser_object_tracker::filtering::AggregateSegmentedFiltering>(std::move(filters),
+                                                                                                  reorder_period);
+  aggregate->setTimingPeriod(timing_period);
+  aggregate->setStatisticsDecay(statistics_decay);
+  return aggregate;
+}
+
+std::unique_ptr<filtering::SegmentMerging> getSegmentMerging(ros::NodeHandle& nh) {
+  bool enabled = false;
+  nh.getParam("merging/enabled", enabled);
+  if (!enabled) {
+    return nullptr;
+  }
+
+  double max_gap_distance = 0.3;
+  int max_skipped_segments = 1;
+  nh.getParam("merging/max_gap_distance", max_gap_distance);
+  nh.getParam("merging/max_skipped_segments", max_skipped_segments);
+
+  return std::make_unique<filtering::SegmentMerging>(max_gap_distance, max_skipped_segments);
 }
 
-std::unique_ptr<laser_object_tracker::tracking::BaseTracking> getTracker() {
-  Eigen::MatrixXd transition(4, 4);
-  transition << 1.0, 0.0, 0.1, 0.0,
-                0.0, 1.0, 0.0, 0.1,
-                0.0, 0.0, 1.0, 0.0,
-                0.0, 0.0, 0.0, 1.0;
+std::unique_ptr<laser_object_tracker::tracking::BaseTracking> getTracker(ros::NodeHandle& nh) {
+  double acceleration_noise = 1.0, position_noise = 1.0, time_step_quantum = 0.001;
+  int cache_size = 64;
+  nh.getParam("tracking/acceleration_noise", acceleration_noise);
+  nh.getParam("tracking/position_noise", position_noise);
+  nh.getParam("tracking/time_step_quantum", time_step_quantum);
+  nh.getParam("tracking/motion_model_cache_size", cache_size);
+  auto motion_model_cache = std::make_shared<laser_object_tracker::tracking::MotionModelCache>(
+      std::make_unique<laser_object_tracker::tracking::ConstantVelocityMotionModel>(2, acceleration_noise,
+                                                                                    position_noise),
+      time_step_quantum,
+      cache_size);
+
+  // Replaced on every prediction with matrices for the actual time step
+  const auto& nominal = motion_model_cache->get(0.1);
+  Eigen::MatrixXd transition = nominal.transition_matrix;
 
   Eigen::MatrixXd measurement(2, 4);
   measurement << 1.0, 0.0, 0.0, 0.0,
                  0.0, 1.0, 0.0, 0.0;
 
-  Eigen::MatrixXd process_noise_covariance(4, 4);
-  process_noise_covariance << 0.1, 0.0, 0.0, 0.0,
-                              0.0, 0.1, 0.0, 0.0,
-                              0.0, 0.0, 0.1, 0.0,
-                              0.0, 0.0, 0.0, 0.1;
+  Eigen::MatrixXd process_noise_covariance = nominal.process_noise_covariance;
 
   Eigen::MatrixXd measurement_noise_covariance(2, 2);
   measurement_noise_covariance << 0.01, 0.00,
@@ -124,17 +267,24 @@ std::unique_ptr<laser_object_tracker::tracking::BaseTracking> getTracker() {
                               0.0, 0.0, 1.0, 0.0,
                               0.0, 0.0, 0.0, 1.0;
 
-  return std::make_unique<laser_object_tracker::tracking::KalmanFilter>(4, 2,
+  auto kalman_filter = std::make_unique<laser_object_tracker::tracking::KalmanFilter>(4, 2,
                           transition,
                           measurement,
                           measurement_noise_covariance,
                           initial_state_covariance,
                           process_noise_covariance);
+  kalman_filter->setMotionModelCache(std::move(motion_model_cache));
+  return kalman_filter;
 }
 
 std::unique_ptr<laser_object_tracker::data_association::BaseDataAssociation> getDataASsociation(ros::NodeHandle& nh) {
   double max_cost;
+  int max_hypotheses = 1;
   nh.getParam("data_association/max_cost", max_cost);
+  nh.getParam("data_association/max_hypotheses", max_hypotheses);
+  if (max_hypotheses > 1) {
+    return std::make_unique<laser_object_tracker::data_association::MurtyAlgorithm>(max_cost);
+  }
   return std::make_unique<laser_object_tracker::data_association::HungarianAlgorithm>(max_cost);
 }
 
@@ -148,6 +298,27 @@ std::unique_ptr<laser_object_tracker::tracking::BaseTrackerRejection> getTracker
   return std::make_unique<laser_object_tracker::tracking::IterationTrackerRejection>(5);
 }
 
+/**
+ * @brief Finds corner of the previous scan closest to the segment centroid, within hint radius.
+ * @return Index of the corner in the context or -1 if there is none
+ */
+int findOrientationHint(const laser_object_tracker::data_types::LaserScanFragment& segment,
+                        const laser_object_tracker::PipelineContext& context,
+                        double hint_radius) {
+  int hint = -1;
+  double best_distance = hint_radius * hint_radius;
+  // Centroids are compared, since the corner of a long object may lie far from the centroid of its segment
+  for (int i = 0; i < context.previous_centroids.size(); ++i) {
+    double distance = (context.previous_centroids.at(i) - segment.descriptor().centroid).squaredNorm();
+    if (distance < best_distance) {
+      best_distance = distance;
+      hint = i;
+    }
+  }
+
+  return hint;
+}
+
 int main(int ac, char **av) {
   pcl::PointCloud<pcl::PointXYZ> pcl;
   pcl::SampleConsenusModelCross2D<pcl::PointXYZ> corner(pcl.makeShared());
@@ -157,7 +328,10 @@ int main(int ac, char **av) {
 
   ROS_INFO("Initializing segmentation");
   auto segmentation = getSegmentation(pnh);
+  background_subtraction = getBackgroundSubtraction(pnh);
+  factory.setRegionOfInterest(getRegionOfInterest(pnh));
   auto filtering = getFiltering(pnh);
+  auto segment_merging = getSegmentMerging(pnh);
 
   std::string feature_type;
   double angle_resolution;
@@ -175,6 +349,24 @@ int main(int ac, char **av) {
   }
   feature_extraction::SearchBasedCornerDetection detection(angle_resolution, criterion);
 
+  // Segments closer than hint radius to a corner from the previous scan search only around its orientation
+  double hint_radius = 0.0;
+  double hint_window = detection.getHintWindow();
+  pnh.getParam("feature_extraction/hint_radius", hint_radius);
+  pnh.getParam("feature_extraction/hint_window", hint_window);
+  detection.setHintWindow(hint_window);
+  double min_hint_assessment = detection.getMinHintAssessment();
+  pnh.getParam("feature_extraction/min_hint_assessment", min_hint_assessment);
+  detection.setMinHintAssessment(min_hint_assessment);
+
+  // Dense segments are thinned before the corner search, 0 spacing keeps all points
+  double min_spacing = 0.0, angular_spacing = 0.0;
+  pnh.getParam("feature_extraction/decimation/min_spacing", min_spacing);
+  pnh.getParam("feature_extraction/decimation/angular_spacing", angular_spacing);
+  if (min_spacing > 0.0 || angular_spacing > 0.0) {
+    detection.setDecimation(std::make_shared<feature_extraction::SegmentDecimation>(min_spacing, angular_spacing));
+  }
+
   ROS_INFO("Initializing visualization");
   std::string base_frame;
   pnh.getParam("base_frame", base_frame);
@@ -182,47 +374,82 @@ int main(int ac, char **av) {
   ROS_INFO("Initializing subscriber");
   ros::Subscriber subscriber_laser_scan = pnh.subscribe("in_scan", 1, laserScanCallback);
 
-  ros::Rate rate(10.0);
+  double loop_rate = 40.0;
+  pnh.getParam("loop_rate", loop_rate);
+  ros::Rate rate(loop_rate);
   ROS_INFO("Done initialization");
 
   laser_object_tracker::tracking::MultiTracker multi_tracker(
       getDistanceFunctor(),
       getDataASsociation(pnh),
-      getTracker(),
+      getTracker(pnh),
       getTrackerRejection());
 
+  int max_hypotheses = 1;
+  double hypothesis_cost_margin = 0.0;
+  pnh.getParam("data_association/max_hypotheses", max_hypotheses);
+  pnh.getParam("data_association/hypothesis_cost_margin", hypothesis_cost_margin);
+  multi_tracker.setMaxHypotheses(max_hypotheses, hypothesis_cost_margin);
+
+  int reserved_tracks = 0;
+  pnh.getParam("tracking/reserved_tracks", reserved_tracks);
+  multi_tracker.reserve(reserved_tracks);
+
+  // Buffers of a single frame, grow during the first frames and are then reused
+  laser_object_tracker::PipelineContext context;
+  context.reserve(reserved_tracks);
+  multi_tracker.setFrameArena(&context.frame_arena);
+
+  ros::Time last_stamp;
   while (ros::ok()) {
     ros::spinOnce();
-    multi_tracker.predict();
+    if (!new_laser_scan) {
+      rate.sleep();
+      continue;
+    }
+    new_laser_scan = false;
+
+    // Predict by the real interval between scans, so skipped frames do not degrade the filter
+    ros::Time stamp = fragment.laserScan().header.stamp;
+    if (!last_stamp.isZero() && stamp > last_stamp) {
+      multi_tracker.predict((stamp - last_stamp).toSec());
+    }
+    last_stamp = stamp;
 
     if (!fragment.empty()) {
       visualization.clearMarkers();
       visualization.publishPointCloud(fragment);
-      auto segments = segmentation->segment(fragment);
-      filtering->filter(segments);
-      ROS_INFO("Detected %lu segments", segments.size());
-      visualization.publishFeatures(segments);
-
-      visualization.publishPointClouds(segments);
-      laser_object_tracker::feature_extraction::features::Corners2D corners_2_d;
-      Eigen::VectorXd feature;
-      std::vector<Eigen::VectorXd> features;
-      for (const auto& segment : segments) {
+      context.clear();
+      segmentation->segment(fragment, context.segments);
+      if (segment_merging) {
+        segment_merging->filter(context.segments);
+      }
+      filtering->filter(context.segments);
+      ROS_INFO("Detected %lu segments", context.segments.size());
+      visualization.publishFeatures(context.segments);
+
+      visualization.publishPointClouds(context.segments);
+      for (const auto& segment : context.segments) {
         if (segment.isValid()) {
-          if (detection.extractFeature(segment, feature)) {
-            features.emplace_back(feature.head<2>());
-//            std::cout << "Feature vector:\n" << feature.head(2) << std::endl;
-            corners_2_d.push_back(laser_object_tracker::feature_extraction::features::Corner2D(feature));
+          int hint = findOrientationHint(segment, context, hint_radius);
+          bool extracted = hint < 0 ?
+                           detection.extractFeature(segment, context.feature) :
+                           detection.extractFeature(segment, context.feature, context.previous_orientations.at(hint));
+          if (extracted) {
+            context.features.emplace_back(context.feature.head<2>());
+            context.corners_2_d.push_back(laser_object_tracker::feature_extraction::features::Corner2D(context.feature));
+            context.centroids.push_back(segment.descriptor().centroid);
+            context.orientations.push_back(detection.getOrientation());
           }
         }
       }
 
-//      Eigen::MatrixXd cost_matrix = multi_tracker.buildCostMatrix(features);
+//      Eigen::MatrixXd cost_matrix = multi_tracker.buildCostMatrix(context.features);
 //      Eigen::VectorXi assignment_vector = multi_tracker.buildAssignmentVector(cost_matrix);
-//      visualization.publishAssignments(multi_tracker, features, cost_matrix, assignment_vector);
+//      visualization.publishAssignments(multi_tracker, context.features, cost_matrix, assignment_vector);
 
-      multi_tracker.update(features);
-      visualization.publishCorners(corners_2_d);
+      multi_tracker.update(context.features);
+      visualization.publishCorners(context.corners_2_d);
       visualization.publishMultiTracker(multi_tracker);
 
       visualization.trigger();
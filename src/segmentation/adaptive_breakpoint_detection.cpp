@@ -45,34 +45,19 @@ AdaptiveBreakpointDetection::AdaptiveBreakpointDetection(double incidence_angle,
 
 std::vector<data_types::LaserScanFragment>
 AdaptiveBreakpointDetection::segment(const data_types::LaserScanFragment& fragment) {
-  if (fragment.empty()) {
-    return {};
-  }
-
-  auto current_begin = fragment.cbegin();
-  auto previous = fragment.cbegin();
-  auto current = fragment.cbegin();
-
   std::vector<data_types::LaserScanFragment> segments;
-  while (current != fragment.cend()) {
-    previous = current++;
-
-    if (!current_begin->isValid()) {
-      current_begin = current;
-    } else if (current == fragment.cend() ||
-        !current->isValid() ||
-        isAboveThreshold(previous->range(), current->range(),
-                         calculateThreshold(previous->range(), fragment.getAngleIncrement()))) {
-      segments.emplace_back(fragment,
-                            current_begin - fragment.cbegin(),
-                            current - fragment.cbegin());
-
-      current_begin = current;
-    }
-  }
+  segment(fragment, segments);
   return segments;
 }
 
+void AdaptiveBreakpointDetection::segment(const data_types::LaserScanFragment& fragment,
+                                          std::vector<data_types::LaserScanFragment>& segments) {
+  const double angle_increment = fragment.getAngleIncrement();
+  chunked_segmentation_.segment(fragment, segments, [this, angle_increment](const auto& previous, const auto& current) {
+    return isAboveThreshold(previous.range(), current.range(), calculateThreshold(previous.range(), angle_increment));
+  });
+}
+
 double AdaptiveBreakpointDetection::getIncidenceAngle() const {
   return incidence_angle_;
 }
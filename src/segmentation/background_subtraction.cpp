@@ -0,0 +1,335 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "laser_object_tracker/segmentation/background_subtraction.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace laser_object_tracker {
+namespace segmentation {
+namespace {
+constexpr char SNAPSHOT_MAGIC[8] = "LOTBGM1";
+
+/**
+ * @brief Fixed size header of a snapshot, followed by history size ranges of every beam.
+ */
+struct SnapshotHeader {
+  char magic[8];
+  char frame_id[64];
+  int64_t beams_number;
+  int64_t scans_number;
+  int32_t history_size;
+  int32_t slot;
+  float angle_min;
+  float angle_increment;
+};
+
+bool writeAll(int descriptor, const void* data, size_t size) {
+  const char* bytes = static_cast<const char*>(data);
+  while (size > 0) {
+    ssize_t written = ::write(descriptor, bytes, size);
+    if (written < 0) {
+      return false;
+    }
+    bytes += written;
+    size -= written;
+  }
+  return true;
+}
+
+bool writeSnapshot(const std::string& path, const std::vector<char>& snapshot) {
+  // Contents reach the disk before the rename, so a power loss leaves either the old or the new snapshot
+  std::string temporary_path = path + ".tmp";
+  int descriptor = ::open(temporary_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (descriptor < 0) {
+    return false;
+  }
+
+  bool written = writeAll(descriptor, snapshot.data(), snapshot.size()) && ::fsync(descriptor) == 0;
+  written = ::close(descriptor) == 0 && written;
+  if (!written || std::rename(temporary_path.c_str(), path.c_str()) != 0) {
+    std::remove(temporary_path.c_str());
+    return false;
+  }
+
+  // Rename itself is persisted with the directory entry
+  std::string::size_type separator = path.find_last_of('/');
+  std::string directory = separator == std::string::npos ? "." : path.substr(0, separator + 1);
+  int directory_descriptor = ::open(directory.c_str(), O_RDONLY);
+  if (directory_descriptor >= 0) {
+    ::fsync(directory_descriptor);
+    ::close(directory_descriptor);
+  }
+
+  return true;
+}
+}  // namespace
+
+BackgroundSubtraction::BackgroundSubtraction(int history_size,
+                                             int min_matches,
+                                             double distance_tolerance,
+                                             int update_period) :
+    history_size_(history_size),
+    update_period_(update_period) {
+  if (history_size < 1) {
+    throw std::invalid_argument("History size needs to be positive. History size: " + std::to_string(history_size));
+  }
+  if (update_period < 1) {
+    throw std::invalid_argument("Update period needs to be positive. Update period: " +
+        std::to_string(update_period));
+  }
+
+  setMinMatches(min_matches);
+  setDistanceTolerance(distance_tolerance);
+}
+
+BackgroundSubtraction::~BackgroundSubtraction() {
+  {
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    stopping_ = true;
+  }
+  snapshot_condition_.notify_all();
+  if (writer_.joinable()) {
+    writer_.join();
+  }
+}
+
+long BackgroundSubtraction::apply(data_types::LaserScanType& laser_scan) {
+  if (laser_scan.ranges.size() != beams_number_ ||
+      laser_scan.header.frame_id != frame_id_ ||
+      laser_scan.angle_min != angle_min_ ||
+      laser_scan.angle_increment != angle_increment_) {
+    reset(laser_scan.ranges.size());
+    frame_id_ = laser_scan.header.frame_id;
+    angle_min_ = laser_scan.angle_min;
+    angle_increment_ = laser_scan.angle_increment;
+  }
+
+  bool record = scans_number_ % update_period_ == 0;
+  long foreground_number = 0;
+  for (long beam = 0; beam < beams_number_; ++beam) {
+    float range = laser_scan.ranges[beam];
+    float* beam_history = &history_[beam * history_size_];
+
+    // Not yet recorded and invalid ranges are NaN or inf, which never match
+    int matches = 0;
+    for (int i = 0; i < history_size_; ++i) {
+      matches += std::abs(beam_history[i] - range) <= distance_tolerance_;
+    }
+
+    if (record) {
+      beam_history[slot_] = range;
+    }
+
+    if (!(range >= laser_scan.range_min && range < laser_scan.range_max)) {
+      continue;
+    }
+
+    if (matches >= min_matches_) {
+      laser_scan.ranges[beam] = std::numeric_limits<float>::infinity();
+    } else {
+      ++foreground_number;
+    }
+  }
+
+  if (record) {
+    slot_ = (slot_ + 1) % history_size_;
+  }
+  ++scans_number_;
+
+  return foreground_number;
+}
+
+void BackgroundSubtraction::reset(long beams_number) {
+  beams_number_ = beams_number;
+  history_.assign(beams_number * history_size_, std::numeric_limits<float>::quiet_NaN());
+  slot_ = 0;
+  scans_number_ = 0;
+}
+
+bool BackgroundSubtraction::save(const std::string& path) const {
+  std::vector<char> snapshot;
+  serialize(snapshot);
+  return writeSnapshot(path, snapshot);
+}
+
+bool BackgroundSubtraction::saveAsync(const std::string& path) {
+  std::lock_guard<std::mutex> lock(snapshot_mutex_);
+  if (snapshot_pending_) {
+    return false;
+  }
+
+  bool written = snapshot_written_;
+  serialize(snapshot_);
+  snapshot_path_ = path;
+  snapshot_pending_ = true;
+  if (!writer_.joinable()) {
+    writer_ = std::thread(&BackgroundSubtraction::writeSnapshots, this);
+  }
+  snapshot_condition_.notify_all();
+  return written;
+}
+
+bool BackgroundSubtraction::waitForSnapshot() {
+  std::unique_lock<std::mutex> lock(snapshot_mutex_);
+  snapshot_condition_.wait(lock, [this]() { return !snapshot_pending_; });
+  return snapshot_written_;
+}
+
+void BackgroundSubtraction::serialize(std::vector<char>& snapshot) const {
+  SnapshotHeader header{};
+  std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+  std::strncpy(header.frame_id, frame_id_.c_str(), sizeof(header.frame_id) - 1);
+  header.beams_number = beams_number_;
+  header.scans_number = scans_number_;
+  header.history_size = history_size_;
+  header.slot = slot_;
+  header.angle_min = angle_min_;
+  header.angle_increment = angle_increment_;
+
+  const char* ranges = reinterpret_cast<const char*>(history_.data());
+  snapshot.assign(reinterpret_cast<const char*>(&header), reinterpret_cast<const char*>(&header) + sizeof(header));
+  snapshot.insert(snapshot.end(), ranges, ranges + history_.size() * sizeof(float));
+}
+
+void BackgroundSubtraction::writeSnapshots() {
+  std::unique_lock<std::mutex> lock(snapshot_mutex_);
+  while (true) {
+    snapshot_condition_.wait(lock, [this]() { return snapshot_pending_ || stopping_; });
+    if (!snapshot_pending_) {
+      return;
+    }
+
+    // Snapshot is not touched by saveAsync() while pending, so it is written without holding the lock
+    lock.unlock();
+    bool written = writeSnapshot(snapshot_path_, snapshot_);
+    lock.lock();
+
+    snapshot_written_ = written;
+    snapshot_pending_ = false;
+    snapshot_condition_.notify_all();
+  }
+}
+
+bool BackgroundSubtraction::load(const std::string& path) {
+  int descriptor = ::open(path.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    return false;
+  }
+
+  struct stat file_status{};
+  if (::fstat(descriptor, &file_status) != 0 || static_cast<size_t>(file_status.st_size) < sizeof(SnapshotHeader)) {
+    ::close(descriptor);
+    return false;
+  }
+
+  size_t file_size = file_status.st_size;
+  void* mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+  ::close(descriptor);
+  if (mapping == MAP_FAILED) {
+    return false;
+  }
+
+  SnapshotHeader header;
+  std::memcpy(&header, mapping, sizeof(header));
+  header.frame_id[sizeof(header.frame_id) - 1] = '\0';
+
+  // Number of beams is bounded by the file size first, so that the expected size cannot overflow
+  const size_t beam_size = history_size_ * sizeof(float);
+  bool valid = std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) == 0 &&
+      header.history_size == history_size_ &&
+      header.beams_number >= 0 &&
+      static_cast<uint64_t>(header.beams_number) <= (file_size - sizeof(header)) / beam_size &&
+      header.slot >= 0 && header.slot < history_size_ &&
+      file_size == sizeof(header) + header.beams_number * beam_size;
+  if (valid) {
+    const auto* ranges = reinterpret_cast<const float*>(static_cast<const char*>(mapping) + sizeof(header));
+    history_.assign(ranges, ranges + header.beams_number * history_size_);
+    beams_number_ = header.beams_number;
+    scans_number_ = header.scans_number;
+    slot_ = header.slot;
+    frame_id_ = header.frame_id;
+    angle_min_ = header.angle_min;
+    angle_increment_ = header.angle_increment;
+  }
+
+  ::munmap(mapping, file_size);
+  return valid;
+}
+
+int BackgroundSubtraction::getHistorySize() const {
+  return history_size_;
+}
+
+int BackgroundSubtraction::getMinMatches() const {
+  return min_matches_;
+}
+
+void BackgroundSubtraction::setMinMatches(int min_matches) {
+  if (min_matches < 1 || min_matches > history_size_) {
+    throw std::invalid_argument("Min matches needs to be in [1, history size]. Min matches: " +
+        std::to_string(min_matches));
+  }
+
+  min_matches_ = min_matches;
+}
+
+double BackgroundSubtraction::getDistanceTolerance() const {
+  return distance_tolerance_;
+}
+
+void BackgroundSubtraction::setDistanceTolerance(double distance_tolerance) {
+  if (distance_tolerance < 0.0) {
+    throw std::invalid_argument("Distance tolerance cannot be negative. Distance tolerance: " +
+        std::to_string(distance_tolerance));
+  }
+
+  distance_tolerance_ = distance_tolerance;
+}
+
+int BackgroundSubtraction::getUpdatePeriod() const {
+  return update_period_;
+}
+}  // namespace segmentation
+}  // namespace laser_object_tracker
@@ -43,33 +43,18 @@ BreakpointDetection::BreakpointDetection(double distance_threshold) :
     distance_threshold_(distance_threshold) {}
 
 std::vector<data_types::LaserScanFragment> BreakpointDetection::segment(const data_types::LaserScanFragment& fragment) {
-  if (fragment.empty()) {
-    return {};
-  }
-
-  auto current_begin = fragment.cbegin();
-  auto previous = fragment.cbegin();
-  auto current = fragment.cbegin();
-
   std::vector<data_types::LaserScanFragment> segments;
-  while (current != fragment.cend()) {
-    previous = current++;
-
-    if (!current_begin->isValid()) {
-      current_begin = current;
-    } else if (current == fragment.cend() ||
-        !current->isValid() ||
-        isAboveThreshold(previous->range(), current->range())) {
-      segments.emplace_back(fragment,
-                            current_begin - fragment.cbegin(),
-                            current - fragment.cbegin());
-
-      current_begin = current;
-    }
-  }
+  segment(fragment, segments);
   return segments;
 }
 
+void BreakpointDetection::segment(const data_types::LaserScanFragment& fragment,
+                                  std::vector<data_types::LaserScanFragment>& segments) {
+  chunked_segmentation_.segment(fragment, segments, [this](const auto& previous, const auto& current) {
+    return isAboveThreshold(previous.range(), current.range());
+  });
+}
+
 bool BreakpointDetection::isAboveThreshold(float previous_range, float current_range) {
   return distance(previous_range, current_range) > distance_threshold_;
 }
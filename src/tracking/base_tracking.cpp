@@ -40,6 +40,10 @@ void laser_object_tracker::tracking::BaseTracking::initFromState() {
   Eigen::VectorXd default_state = Eigen::VectorXd::Zero(state_dimensions_);
   initFromState(default_state);
 }
+void laser_object_tracker::tracking::BaseTracking::predict(double time_step) {
+  predict();
+}
+
 void laser_object_tracker::tracking::BaseTracking::initFromMeasurement() {
   Eigen::VectorXd measurement = Eigen::VectorXd::Zero(measurement_dimensions_);
   initFromMeasurement(measurement);
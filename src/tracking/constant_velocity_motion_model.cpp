@@ -0,0 +1,91 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "laser_object_tracker/tracking/constant_velocity_motion_model.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace laser_object_tracker {
+namespace tracking {
+
+ConstantVelocityMotionModel::ConstantVelocityMotionModel(int dimensions,
+                                                         double acceleration_noise,
+                                                         double position_noise)
+    : dimensions_(dimensions),
+      acceleration_noise_(acceleration_noise),
+      position_noise_(position_noise) {
+  if (dimensions_ < 1) {
+    throw std::invalid_argument("Dimensions need to be positive. Dimensions: " + std::to_string(dimensions_));
+  }
+  if (acceleration_noise_ < 0.0) {
+    throw std::invalid_argument("Acceleration noise cannot be negative. Noise: " +
+        std::to_string(acceleration_noise_));
+  }
+  if (position_noise_ < 0.0) {
+    throw std::invalid_argument("Position noise cannot be negative. Noise: " + std::to_string(position_noise_));
+  }
+}
+
+void ConstantVelocityMotionModel::discretize(double time_step,
+                                             Eigen::MatrixXd& transition_matrix,
+                                             Eigen::MatrixXd& process_noise_covariance) const {
+  const Eigen::MatrixXd identity = Eigen::MatrixXd::Identity(dimensions_, dimensions_);
+
+  transition_matrix.setIdentity(2 * dimensions_, 2 * dimensions_);
+  transition_matrix.topRightCorner(dimensions_, dimensions_) = time_step * identity;
+
+  double time_step_2 = time_step * time_step;
+  double time_step_3 = time_step_2 * time_step;
+  process_noise_covariance.resize(2 * dimensions_, 2 * dimensions_);
+  process_noise_covariance.topLeftCorner(dimensions_, dimensions_) =
+      (acceleration_noise_ * time_step_3 / 3.0 + position_noise_ * time_step) * identity;
+  process_noise_covariance.topRightCorner(dimensions_, dimensions_) = acceleration_noise_ * time_step_2 / 2.0 * identity;
+  process_noise_covariance.bottomLeftCorner(dimensions_, dimensions_) =
+      acceleration_noise_ * time_step_2 / 2.0 * identity;
+  process_noise_covariance.bottomRightCorner(dimensions_, dimensions_) = acceleration_noise_ * time_step * identity;
+}
+
+int ConstantVelocityMotionModel::getDimensions() const {
+  return dimensions_;
+}
+
+double ConstantVelocityMotionModel::getAccelerationNoise() const {
+  return acceleration_noise_;
+}
+
+double ConstantVelocityMotionModel::getPositionNoise() const {
+  return position_noise_;
+}
+}  // namespace tracking
+}  // namespace laser_object_tracker
@@ -56,6 +56,10 @@ std::unique_ptr<BaseTrackerRejection> IterationTrackerRejection::clone() const {
   return std::unique_ptr<BaseTrackerRejection>(new IterationTrackerRejection(*this));
 }
 
+void IterationTrackerRejection::resetFrom(const BaseTrackerRejection& prototype) {
+  *this = dynamic_cast<const IterationTrackerRejection&>(prototype);
+}
+
 int IterationTrackerRejection::getMaxIterationsWithoutUpdate() const {
   return max_iterations_without_update_;
 }
@@ -37,6 +37,14 @@
 
 namespace laser_object_tracker {
 namespace tracking {
+namespace {
+/**
+ * @brief Wraps the vector in a column Mat header, its data is neither copied nor allocated.
+ */
+cv::Mat columnView(const Eigen::VectorXd& vector) {
+  return cv::Mat(vector.rows(), 1, CV_64F, const_cast<double*>(vector.data()));
+}
+}  // namespace
 
 KalmanFilter::KalmanFilter(int state_dimensions,
                            int measurement_dimensions,
@@ -59,7 +67,8 @@ KalmanFilter::KalmanFilter(int state_dimensions,
 
 KalmanFilter::KalmanFilter(const KalmanFilter& other) noexcept
     : BaseTracking(other),
-      kalman_filter_(other.state_dimensions_, other.measurement_dimensions_, 0, CV_64F) {
+      kalman_filter_(other.state_dimensions_, other.measurement_dimensions_, 0, CV_64F),
+      motion_model_cache_(other.motion_model_cache_) {
   copyMats(other);
 }
 
@@ -67,6 +76,7 @@ KalmanFilter& KalmanFilter::operator=(const KalmanFilter& other) noexcept {
   BaseTracking::operator=(other);
   kalman_filter_.init(other.state_dimensions_, other.measurement_dimensions_, 0, CV_64F);
   copyMats(other);
+  motion_model_cache_ = other.motion_model_cache_;
   return *this;
 }
 
@@ -74,10 +84,18 @@ void KalmanFilter::predict() {
   kalman_filter_.predict();
 }
 
+void KalmanFilter::predict(double time_step) {
+  if (motion_model_cache_) {
+    const auto& entry = motion_model_cache_->get(time_step);
+    // Destination mats already have matching size, so no reallocation happens
+    cv::eigen2cv(entry.transition_matrix, kalman_filter_.transitionMatrix);
+    cv::eigen2cv(entry.process_noise_covariance, kalman_filter_.processNoiseCov);
+  }
+  kalman_filter_.predict();
+}
+
 void KalmanFilter::update(const Eigen::VectorXd& measurement) {
-  cv::Mat measurement_cv;
-  cv::eigen2cv(measurement, measurement_cv);
-  kalman_filter_.correct(measurement_cv);
+  kalman_filter_.correct(columnView(measurement));
 }
 
 Eigen::VectorXd KalmanFilter::getStateVector() const {
@@ -90,13 +108,24 @@ std::unique_ptr<BaseTracking> KalmanFilter::clone() const {
   return std::unique_ptr<BaseTracking>(new KalmanFilter(*this));
 }
 
+void KalmanFilter::resetFrom(const BaseTracking& prototype) {
+  const auto& other = dynamic_cast<const KalmanFilter&>(prototype);
+  BaseTracking::operator=(other);
+  // Mats of equal size and type are copied without reallocation
+  copyMats(other);
+  motion_model_cache_ = other.motion_model_cache_;
+}
+
+void KalmanFilter::setMotionModelCache(std::shared_ptr<MotionModelCache> motion_model_cache) {
+  motion_model_cache_ = std::move(motion_model_cache);
+}
+
 void KalmanFilter::initFromState(const Eigen::VectorXd& init_state) {
   cv::eigen2cv(init_state, kalman_filter_.statePost);
 }
 void KalmanFilter::initFromMeasurement(const Eigen::VectorXd& measurement) {
-  cv::Mat measurement_cv;
-  cv::eigen2cv(measurement, measurement_cv);
-  kalman_filter_.statePost = inverse_measurement_matrix_ * measurement_cv;
+  // State post already has matching size, so the product is written in place
+  cv::gemm(inverse_measurement_matrix_, columnView(measurement), 1.0, cv::noArray(), 0.0, kalman_filter_.statePost);
 }
 
 void KalmanFilter::copyMats(const KalmanFilter& other) {
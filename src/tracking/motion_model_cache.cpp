@@ -0,0 +1,84 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include "laser_object_tracker/tracking/motion_model_cache.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace laser_object_tracker {
+namespace tracking {
+
+MotionModelCache::MotionModelCache(std::unique_ptr<BaseMotionModel> motion_model, double time_step_quantum, int size)
+    : motion_model_(std::move(motion_model)),
+      time_step_quantum_(time_step_quantum) {
+  if (!motion_model_) {
+    throw std::invalid_argument("Motion model cannot be empty.");
+  }
+  if (time_step_quantum_ <= 0.0) {
+    throw std::invalid_argument("Time step quantum needs to be positive. Quantum: " +
+        std::to_string(time_step_quantum_));
+  }
+  if (size < 1) {
+    throw std::invalid_argument("Cache size needs to be positive. Size: " + std::to_string(size));
+  }
+
+  entries_.resize(size);
+}
+
+const MotionModelCache::Entry& MotionModelCache::get(double time_step) {
+  if (time_step < 0.0) {
+    throw std::invalid_argument("Time step cannot be negative. Time step: " + std::to_string(time_step));
+  }
+
+  long key = std::lround(time_step / time_step_quantum_);
+  Entry& entry = entries_.at(key % entries_.size());
+  if (entry.key != key) {
+    entry.key = key;
+    entry.time_step = key * time_step_quantum_;
+    motion_model_->discretize(entry.time_step, entry.transition_matrix, entry.process_noise_covariance);
+  }
+
+  return entry;
+}
+
+double MotionModelCache::getTimeStepQuantum() const {
+  return time_step_quantum_;
+}
+
+int MotionModelCache::size() const {
+  return entries_.size();
+}
+}  // namespace tracking
+}  // namespace laser_object_tracker
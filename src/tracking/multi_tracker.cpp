@@ -33,18 +33,21 @@
 
 #include "laser_object_tracker/tracking/multi_tracker.hpp"
 
-#include <numeric>
+#include <stdexcept>
+#include <string>
 
 namespace laser_object_tracker {
 namespace tracking {
+constexpr int MultiTracker::AMBIGUOUS_ASSIGNMENT;
+
 MultiTracker::MultiTracker(DistanceFunctor distance_calculator,
                            std::unique_ptr<data_association::BaseDataAssociation> data_association,
                            std::unique_ptr<BaseTracking> tracker_prototype,
                            std::unique_ptr<BaseTrackerRejection> tracker_rejector_prototype)
     : distance_calculator_(std::move(distance_calculator)),
       data_association_(std::move(data_association)),
-      tracker_prototype_(std::move(tracker_prototype)),
-      tracker_rejector_prototype_(std::move(tracker_rejector_prototype)) {}
+      trackers_pool_(std::move(tracker_prototype)),
+      trackers_rejections_pool_(std::move(tracker_rejector_prototype)) {}
 
 void MultiTracker::predict() {
   for (auto& tracker : trackers_) {
@@ -52,14 +55,38 @@ void MultiTracker::predict() {
   }
 }
 
+void MultiTracker::predict(double time_step) {
+  for (auto& tracker : trackers_) {
+    tracker->predict(time_step);
+  }
+}
+
 void MultiTracker::update(const std::vector<Eigen::VectorXd>& measurements) {
-  Eigen::MatrixXd cost_matrix = buildCostMatrix(measurements);
+  if (frame_arena_ == nullptr) {
+    updateWithCostMatrix(measurements, buildCostMatrix(measurements));
+    return;
+  }
 
-  Eigen::VectorXi assignment_vector = buildAssignmentVector(cost_matrix);
+  Eigen::Map<Eigen::MatrixXd> cost_matrix(frame_arena_->allocate<double>(trackers_.size() * measurements.size()),
+                                          trackers_.size(),
+                                          measurements.size());
+  fillCostMatrix(measurements, cost_matrix);
+  updateWithCostMatrix(measurements, cost_matrix);
+}
+
+void MultiTracker::updateWithCostMatrix(const std::vector<Eigen::VectorXd>& measurements,
+                                        const CostMatrix& cost_matrix) {
+  // Single hypothesis is solved directly into the member vector, which is not reallocated while the number of
+  // measurements stays the same
+  if (max_hypotheses_ > 1) {
+    assignment_vector_ = buildAssignmentVector(cost_matrix);
+  } else {
+    data_association_->solve(cost_matrix, data_association_->NOT_NEEDED, assignment_vector_);
+  }
 
-  updateAndInitializeTracks(measurements, assignment_vector);
+  updateAndInitializeTracks(measurements, assignment_vector_);
 
-  handleNotUpdatedTracks(assignment_vector);
+  handleNotUpdatedTracks(assignment_vector_);
 
   handleRejectedTracks();
 }
@@ -88,73 +115,142 @@ int MultiTracker::size() const {
   return trackers_.size();
 }
 
+void MultiTracker::reserve(int tracks_number) {
+  trackers_.reserve(tracks_number);
+  trackers_rejections_.reserve(tracks_number);
+  trackers_pool_.reserve(tracks_number);
+  trackers_rejections_pool_.reserve(tracks_number);
+}
+
+void MultiTracker::setMaxHypotheses(int max_hypotheses, double hypothesis_cost_margin) {
+  if (max_hypotheses < 1) {
+    throw std::invalid_argument("Max hypotheses needs to be positive. Max hypotheses: " +
+        std::to_string(max_hypotheses));
+  }
+  if (hypothesis_cost_margin < 0.0) {
+    throw std::invalid_argument("Hypothesis cost margin cannot be negative. Margin: " +
+        std::to_string(hypothesis_cost_margin));
+  }
+
+  max_hypotheses_ = max_hypotheses;
+  hypothesis_cost_margin_ = hypothesis_cost_margin;
+}
+
 Eigen::MatrixXd MultiTracker::buildCostMatrix(const std::vector<Eigen::VectorXd>& measurements) {
   Eigen::MatrixXd cost_matrix(trackers_.size(), measurements.size());
+  fillCostMatrix(measurements, cost_matrix);
+
+  return cost_matrix;
+}
+
+void MultiTracker::fillCostMatrix(const std::vector<Eigen::VectorXd>& measurements,
+                                  Eigen::Ref<Eigen::MatrixXd> cost_matrix) const {
   for (int row = 0; row < cost_matrix.rows(); ++row) {
     for (int col = 0; col < cost_matrix.cols(); ++col) {
       cost_matrix(row, col) = distance_calculator_(measurements.at(col), *trackers_.at(row));
     }
   }
-
-  return cost_matrix;
 }
 
-Eigen::VectorXi MultiTracker::buildAssignmentVector(const Eigen::MatrixXd& cost_matrix) {
+Eigen::VectorXi MultiTracker::buildAssignmentVector(const CostMatrix& cost_matrix) {
+  if (max_hypotheses_ > 1) {
+    std::vector<double> costs;
+    std::vector<Eigen::VectorXi> assignment_vectors = buildAssignmentHypotheses(cost_matrix, costs);
+    // No feasible hypothesis, e.g. every cost of a track is infinite, single solution handles it per measurement
+    if (!assignment_vectors.empty()) {
+      return resolveAssignmentHypotheses(assignment_vectors, costs);
+    }
+  }
+
   Eigen::VectorXi assignment_vector;
   data_association_->solve(cost_matrix, data_association_->NOT_NEEDED, assignment_vector);
 
   return assignment_vector;
 }
 
+std::vector<Eigen::VectorXi> MultiTracker::buildAssignmentHypotheses(const CostMatrix& cost_matrix,
+                                                                     std::vector<double>& costs) {
+  std::vector<Eigen::VectorXi> assignment_vectors;
+  data_association_->solveKBest(cost_matrix, max_hypotheses_, assignment_vectors, costs);
+
+  return assignment_vectors;
+}
+
+Eigen::VectorXi MultiTracker::resolveAssignmentHypotheses(const std::vector<Eigen::VectorXi>& assignment_vectors,
+                                                          const std::vector<double>& costs) {
+  if (assignment_vectors.empty()) {
+    throw std::invalid_argument("At least one assignment hypothesis is needed.");
+  }
+
+  Eigen::VectorXi assignment_vector = assignment_vectors.front();
+  for (int i = 1; i < assignment_vectors.size(); ++i) {
+    // Costs exclude gated out pairs, so hypotheses are not necessarily sorted by them
+    if (costs.at(i) > costs.front() + hypothesis_cost_margin_) {
+      continue;
+    }
+
+    // Measurements associated differently in a competing hypothesis are not trusted
+    for (int col = 0; col < assignment_vector.size(); ++col) {
+      if (assignment_vectors.at(i)(col) != assignment_vectors.front()(col)) {
+        assignment_vector(col) = AMBIGUOUS_ASSIGNMENT;
+      }
+    }
+  }
+
+  return assignment_vector;
+}
+
 void MultiTracker::updateAndInitializeTracks(const std::vector<Eigen::VectorXd>& measurements,
                                              const Eigen::VectorXi& assignment_vector) {
   for (int i = 0; i < measurements.size(); ++i) {
-    if (assignment_vector(i) != data_association_->NO_ASSIGNMENT) {
+    if (assignment_vector(i) == AMBIGUOUS_ASSIGNMENT) {
+      continue;
+    } else if (assignment_vector(i) != data_association_->NO_ASSIGNMENT) {
       int tracker_index = assignment_vector(i);
       trackers_.at(tracker_index)->update(measurements.at(i));
       trackers_rejections_.at(tracker_index)->updated(*trackers_.at(tracker_index));
     } else {
-      trackers_.push_back(std::move(tracker_prototype_->clone()));
+      trackers_.push_back(trackers_pool_.acquire());
       trackers_.back()->initFromMeasurement(measurements.at(i));
-      trackers_rejections_.push_back(std::move(tracker_rejector_prototype_->clone()));
+      trackers_rejections_.push_back(trackers_rejections_pool_.acquire());
     }
   }
 }
 
 void MultiTracker::handleNotUpdatedTracks(const Eigen::VectorXi& assignment_vector) {
-  std::vector<int> trackers_indices(trackers_.size());
-  std::iota(trackers_indices.begin(), trackers_indices.end(), 0);
-
-  std::vector<int> updated_trackers(assignment_vector.data(), assignment_vector.data() + assignment_vector.size());
-  std::sort(updated_trackers.begin(), updated_trackers.end());
-
-  std::vector<int> not_updated_trackers;
-  not_updated_trackers.reserve(trackers_indices.size());
-  std::set_difference(trackers_indices.begin(),
-                      trackers_indices.end(),
-                      updated_trackers.begin(),
-                      updated_trackers.end(),
-                      std::back_inserter(not_updated_trackers));
-
-  for (int index : not_updated_trackers) {
-    trackers_rejections_.at(index)->notUpdated(*trackers_.at(index));
+  updated_trackers_.assign(trackers_.size(), false);
+  for (int i = 0; i < assignment_vector.size(); ++i) {
+    if (assignment_vector(i) >= 0) {
+      updated_trackers_.at(assignment_vector(i)) = true;
+    }
+  }
+
+  for (int index = 0; index < trackers_.size(); ++index) {
+    if (!updated_trackers_.at(index)) {
+      trackers_rejections_.at(index)->notUpdated(*trackers_.at(index));
+    }
   }
 }
 
 void MultiTracker::handleRejectedTracks() {
-  auto trackers_it = trackers_.cbegin();
-  auto rejectors_it = trackers_rejections_.cbegin();
-  for (; trackers_it != trackers_.cend(); ) {
-    const auto& tracker = **trackers_it;
-    const auto& rejector = **rejectors_it;
-    if (rejector.invalidate(tracker)) {
-      trackers_it = trackers_.erase(trackers_it);
-      rejectors_it = trackers_rejections_.erase(rejectors_it);
+  // Stable compaction, surviving tracks are moved towards the front in a single pass
+  int kept = 0;
+  for (int index = 0; index < trackers_.size(); ++index) {
+    if (trackers_rejections_.at(index)->invalidate(*trackers_.at(index))) {
+      // Rejected instances are recycled for future tracks
+      trackers_pool_.release(std::move(trackers_.at(index)));
+      trackers_rejections_pool_.release(std::move(trackers_rejections_.at(index)));
     } else {
-      ++trackers_it;
-      ++rejectors_it;
+      if (kept != index) {
+        trackers_.at(kept) = std::move(trackers_.at(index));
+        trackers_rejections_.at(kept) = std::move(trackers_rejections_.at(index));
+      }
+      ++kept;
     }
   }
+
+  trackers_.erase(trackers_.begin() + kept, trackers_.end());
+  trackers_rejections_.erase(trackers_rejections_.begin() + kept, trackers_rejections_.end());
 }
 }  // namespace tracking
 }  // namespace laser_object_tracker
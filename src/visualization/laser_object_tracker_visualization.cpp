@@ -35,8 +35,6 @@
 
 #include <random>
 
-#include <opencv2/imgproc/imgproc.hpp>
-
 namespace laser_object_tracker {
 namespace visualization {
 
@@ -187,16 +185,9 @@ void LaserObjectTrackerVisualization::publishAssignments(const tracking::MultiTr
 
 void LaserObjectTrackerVisualization::publishFeatures(const std::vector<data_types::LaserScanFragment>& fragments) {
   for (const auto& fragment : fragments) {
-    std::vector<cv::Point2f> points(fragment.size());
-    for (int i = 0; i < fragment.size(); ++i) {
-      points.at(i).x = fragment.at(i).point().x;
-      points.at(i).y = fragment.at(i).point().y;
-    }
-    auto rectangle = cv::minAreaRect(points);
-
     using namespace std::string_literals;
     std::string info = "Points: "s + std::to_string(fragment.size()) +
-                       " Area: "s + std::to_string(rectangle.size.area()) + " m^2"s;
+                       " Area: "s + std::to_string(fragment.descriptor().obb.area()) + " m^2"s;
 
     geometry_msgs::Point point;
     point.x = fragment.at(0).point().x;
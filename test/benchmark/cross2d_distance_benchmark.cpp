@@ -0,0 +1,120 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include <pcl/point_types.h>
+
+#include "laser_object_tracker/feature_extraction/pcl/sac_model_cross2d.hpp"
+
+namespace {
+constexpr int POINTS_NUMBER = 1000;
+constexpr int HYPOTHESES_NUMBER = 10000;
+constexpr double THRESHOLD = 0.5;
+
+using PointCloud = pcl::PointCloud<pcl::PointXYZ>;
+using Model = pcl::SampleConsenusModelCross2D<pcl::PointXYZ>;
+
+/**
+ * @brief Point by point implementation, which the vectorized kernel replaced
+ */
+int countWithinDistanceReference(const PointCloud& cloud, const Eigen::VectorXf& model_coefficients,
+                                 double threshold) {
+  Eigen::Vector4f corner_point(model_coefficients[0], model_coefficients[1], 0.0, 0.0);
+  Eigen::Vector4f line_1_direction(model_coefficients[2], model_coefficients[3], 0.0, 0.0);
+  Eigen::Vector4f line_2_direction(model_coefficients[3], -model_coefficients[2], 0.0, 0.0);
+  line_1_direction.normalize();
+  line_2_direction.normalize();
+
+  int point_number = 0;
+  for (const auto& cloud_point : cloud.points) {
+    Eigen::Vector4f point(cloud_point.x, cloud_point.y, 0.0, 0.0);
+    double squared_distance = std::min(pcl::sqrPointToLineDistance(point, corner_point, line_1_direction),
+                                       pcl::sqrPointToLineDistance(point, corner_point, line_2_direction));
+    if (squared_distance < threshold * threshold) {
+      ++point_number;
+    }
+  }
+  return point_number;
+}
+
+template<class Function>
+std::chrono::duration<double, std::micro> measure(const std::vector<Eigen::VectorXf>& hypotheses,
+                                                  Function function,
+                                                  long& inliers) {
+  inliers = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (const auto& hypothesis : hypotheses) {
+    inliers += function(hypothesis);
+  }
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start) / hypotheses.size();
+}
+}  // namespace
+
+int main(int ac, char** av) {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<float> distribution(-5.0f, 5.0f);
+
+  PointCloud cloud;
+  for (int i = 0; i < POINTS_NUMBER; ++i) {
+    cloud.push_back({distribution(generator), distribution(generator), 0.0});
+  }
+  Model model(cloud.makeShared());
+
+  std::vector<Eigen::VectorXf> hypotheses(HYPOTHESES_NUMBER, Eigen::VectorXf(4));
+  for (auto& hypothesis : hypotheses) {
+    hypothesis << distribution(generator), distribution(generator), distribution(generator), distribution(generator);
+  }
+
+  long reference_inliers, count_inliers, select_inliers;
+  auto reference_time = measure(hypotheses, [&](const Eigen::VectorXf& hypothesis) {
+    return countWithinDistanceReference(cloud, hypothesis, THRESHOLD);
+  }, reference_inliers);
+  auto count_time = measure(hypotheses, [&](const Eigen::VectorXf& hypothesis) {
+    return model.countWithinDistance(hypothesis, THRESHOLD);
+  }, count_inliers);
+  std::vector<int> inliers;
+  auto select_time = measure(hypotheses, [&](const Eigen::VectorXf& hypothesis) {
+    model.selectWithinDistance(hypothesis, THRESHOLD, inliers);
+    return inliers.size();
+  }, select_inliers);
+
+  std::cout << "Points: " << POINTS_NUMBER << ", hypotheses: " << HYPOTHESES_NUMBER << "\n"
+            << "Point by point countWithinDistance: " << reference_time.count() << " us\n"
+            << "Vectorized countWithinDistance: " << count_time.count() << " us\n"
+            << "Vectorized selectWithinDistance: " << select_time.count() << " us\n";
+
+  return reference_inliers == count_inliers && reference_inliers == select_inliers ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include <pcl/point_types.h>
+#include <unsupported/Eigen/NonLinearOptimization>
+#include <unsupported/Eigen/NumericalDiff>
+
+#include "laser_object_tracker/feature_extraction/pcl/sac_model_cross2d.hpp"
+
+namespace {
+constexpr int ARM_POINTS_NUMBER = 100;
+constexpr int REPETITIONS = 1000;
+
+using PointCloud = pcl::PointCloud<pcl::PointXYZ>;
+using Model = pcl::SampleConsenusModelCross2D<pcl::PointXYZ>;
+
+/**
+ * @brief Residuals of the numerically differentiated refinement, which the analytic Jacobian replaced
+ */
+struct ReferenceFunctor : pcl::Functor<float> {
+  ReferenceFunctor(const PointCloud& cloud) : pcl::Functor<float>(cloud.size()), cloud_(cloud) {}
+
+  int operator()(const Eigen::VectorXf& x, Eigen::VectorXf& fvec) const {
+    Eigen::Vector4f corner_point(x[0], x[1], 0.0, 0.0);
+    Eigen::Vector4f line_1_direction(x[2], x[3], 0.0, 0.0);
+    Eigen::Vector4f line_2_direction(x[3], -x[2], 0.0, 0.0);
+    line_1_direction.normalize();
+    line_2_direction.normalize();
+
+    for (int i = 0; i < values(); ++i) {
+      Eigen::Vector4f point(cloud_.points[i].x, cloud_.points[i].y, 0.0, 0.0);
+      fvec[i] = std::min(pcl::sqrPointToLineDistance(point, corner_point, line_1_direction),
+                         pcl::sqrPointToLineDistance(point, corner_point, line_2_direction));
+    }
+    return 0;
+  }
+
+  const PointCloud& cloud_;
+};
+
+template<class Function>
+std::chrono::duration<double, std::micro> measure(Function function) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < REPETITIONS; ++i) {
+    function();
+  }
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start) / REPETITIONS;
+}
+}  // namespace
+
+int main(int ac, char** av) {
+  std::mt19937 generator(0);
+  std::normal_distribution<float> noise(0.0f, 0.01f);
+
+  // Noisy corner at (1, 2) with arms along (1, 1) and (1, -1)
+  PointCloud cloud;
+  std::vector<int> inliers;
+  for (int i = 0; i < ARM_POINTS_NUMBER; ++i) {
+    inliers.push_back(cloud.size());
+    cloud.push_back({1.0f + 0.02f * i + noise(generator), 2.0f + 0.02f * i + noise(generator), 0.0f});
+    inliers.push_back(cloud.size());
+    cloud.push_back({1.0f + 0.02f * (i + 1) + noise(generator), 2.0f - 0.02f * (i + 1) + noise(generator), 0.0f});
+  }
+  Model model(cloud.makeShared());
+
+  Eigen::VectorXf initial_coefficients(4);
+  initial_coefficients << 1.05, 1.95, 0.6, 0.8;
+
+  Eigen::VectorXf reference_coefficients;
+  auto reference_time = measure([&]() {
+    reference_coefficients = initial_coefficients;
+    ReferenceFunctor functor(cloud);
+    Eigen::NumericalDiff<ReferenceFunctor> numerical_diff(functor);
+    Eigen::LevenbergMarquardt<Eigen::NumericalDiff<ReferenceFunctor>, float> levenberg_marquardt(numerical_diff);
+    levenberg_marquardt.minimize(reference_coefficients);
+  });
+
+  Eigen::VectorXf analytic_coefficients;
+  auto analytic_time = measure([&]() {
+    model.optimizeModelCoefficients(inliers, initial_coefficients, analytic_coefficients);
+  });
+
+  std::cout << "Inliers: " << inliers.size() << "\n"
+            << "Numerical differentiation: " << reference_time.count() << " us, corner "
+            << reference_coefficients.head<2>().transpose() << "\n"
+            << "Analytic Jacobian: " << analytic_time.count() << " us, corner "
+            << analytic_coefficients.head<2>().transpose() << "\n";
+
+  return (reference_coefficients.head<2>() - analytic_coefficients.head<2>()).norm() < 0.01 ? 0 : 1;
+}
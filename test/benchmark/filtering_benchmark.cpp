@@ -0,0 +1,129 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include "laser_object_tracker/filtering/aggregate_segmented_filtering.hpp"
+#include "laser_object_tracker/filtering/obb_area_filter.hpp"
+#include "laser_object_tracker/filtering/points_number_filter.hpp"
+#include "laser_object_tracker/filtering/static_filter_cascade.hpp"
+
+namespace {
+constexpr int SCAN_SIZE = 100000;
+constexpr int REPETITIONS = 100;
+
+using laser_object_tracker::data_types::LaserScanFragment;
+using laser_object_tracker::filtering::OBBAreaFilter;
+using laser_object_tracker::filtering::PointsNumberFilter;
+
+/**
+ * @brief Cuts a synthetic scan into segments of random size, so that both filters reject some of them
+ */
+std::vector<LaserScanFragment> generateSegments() {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<float> range_distribution(1.0f, 10.0f);
+  std::uniform_int_distribution<long> size_distribution(1, 40);
+
+  laser_object_tracker::data_types::LaserScanType laser_scan;
+  laser_scan.angle_min = -M_PI;
+  laser_scan.angle_max = M_PI;
+  laser_scan.angle_increment = 2.0 * M_PI / (SCAN_SIZE - 1);
+  laser_scan.range_min = 0.0;
+  laser_scan.range_max = 20.0;
+  laser_scan.ranges.resize(SCAN_SIZE);
+  for (auto& range : laser_scan.ranges) {
+    range = range_distribution(generator);
+  }
+
+  LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(laser_scan);
+
+  std::vector<LaserScanFragment> segments;
+  for (long first = 0; first < fragment.size();) {
+    long last = std::min<long>(first + size_distribution(generator), fragment.size());
+    segments.emplace_back(fragment, first, last);
+    first = last;
+  }
+
+  return segments;
+}
+
+std::chrono::duration<double, std::micro> measure(const laser_object_tracker::filtering::BaseSegmentedFiltering& filter,
+                                                  const std::vector<LaserScanFragment>& segments,
+                                                  size_t& remaining) {
+  std::chrono::duration<double, std::micro> total(0.0);
+  for (int i = 0; i < REPETITIONS; ++i) {
+    auto copy = segments;
+    auto start = std::chrono::steady_clock::now();
+    filter.filter(copy);
+    total += std::chrono::steady_clock::now() - start;
+    remaining = copy.size();
+  }
+
+  return total / REPETITIONS;
+}
+}  // namespace
+
+int main(int ac, char** av) {
+  auto segments = generateSegments();
+
+  PointsNumberFilter points_filter(10, 30);
+  OBBAreaFilter obb_filter(0.005, 2.0, 0.05);
+
+  std::vector<std::unique_ptr<laser_object_tracker::filtering::BaseSegmentedFiltering>> fixed_filters;
+  fixed_filters.push_back(std::make_unique<PointsNumberFilter>(points_filter));
+  fixed_filters.push_back(std::make_unique<OBBAreaFilter>(obb_filter));
+  laser_object_tracker::filtering::AggregateSegmentedFiltering fixed(std::move(fixed_filters), 0);
+
+  std::vector<std::unique_ptr<laser_object_tracker::filtering::BaseSegmentedFiltering>> adaptive_filters;
+  adaptive_filters.push_back(std::make_unique<OBBAreaFilter>(obb_filter));
+  adaptive_filters.push_back(std::make_unique<PointsNumberFilter>(points_filter));
+  laser_object_tracker::filtering::AggregateSegmentedFiltering adaptive(std::move(adaptive_filters));
+
+  laser_object_tracker::filtering::StaticFilterCascade<PointsNumberFilter, OBBAreaFilter> cascade(points_filter,
+                                                                                                  obb_filter);
+
+  size_t fixed_remaining, adaptive_remaining, cascade_remaining;
+  auto fixed_time = measure(fixed, segments, fixed_remaining);
+  auto adaptive_time = measure(adaptive, segments, adaptive_remaining);
+  auto cascade_time = measure(cascade, segments, cascade_remaining);
+
+  std::cout << "Segments: " << segments.size() << ", remaining: " << cascade_remaining << "\n"
+            << "AggregateSegmentedFiltering, fixed order: " << fixed_time.count() << " us\n"
+            << "AggregateSegmentedFiltering, adaptive order: " << adaptive_time.count() << " us\n"
+            << "StaticFilterCascade: " << cascade_time.count() << " us\n";
+
+  return fixed_remaining == cascade_remaining && adaptive_remaining == cascade_remaining ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <chrono>
+#include <iostream>
+
+#include "laser_object_tracker/data_association/hungarian_algorithm.hpp"
+#include "laser_object_tracker/tracking/multi_tracker.hpp"
+
+namespace {
+constexpr int TRACKS = 1000;
+constexpr int REPETITIONS = 100;
+
+using laser_object_tracker::tracking::BaseTrackerRejection;
+using laser_object_tracker::tracking::BaseTracking;
+
+class PositionTracking : public BaseTracking {
+ public:
+  PositionTracking() : BaseTracking(2, 2), state_(Eigen::VectorXd::Zero(2)) {}
+
+  void initFromState(const Eigen::VectorXd& init_state) override {
+    state_ = init_state;
+  }
+
+  void initFromMeasurement(const Eigen::VectorXd& measurement) override {
+    state_ = measurement;
+  }
+
+  void predict() override {}
+
+  void update(const Eigen::VectorXd& measurement) override {
+    state_ = measurement;
+  }
+
+  Eigen::VectorXd getStateVector() const override {
+    return state_;
+  }
+
+  std::unique_ptr<BaseTracking> clone() const override {
+    return std::unique_ptr<BaseTracking>(new PositionTracking(*this));
+  }
+
+  void resetFrom(const BaseTracking& prototype) override {
+    *this = dynamic_cast<const PositionTracking&>(prototype);
+  }
+
+ private:
+  Eigen::VectorXd state_;
+};
+
+/**
+ * @brief Rejects nine out of ten tracks once they are not updated, as if a crowd left the field of view.
+ * Remaining tracks are rejected after the second iteration without update.
+ */
+class MassExpiryRejection : public BaseTrackerRejection {
+ public:
+  bool invalidate(const BaseTracking& tracker) const override {
+    return iterations_without_update_ > 1 ||
+        (iterations_without_update_ > 0 && static_cast<int>(tracker.getStateVector()(0)) % 10 != 0);
+  }
+
+  void notUpdated(const BaseTracking& tracker) override {
+    ++iterations_without_update_;
+  }
+
+  std::unique_ptr<BaseTrackerRejection> clone() const override {
+    return std::unique_ptr<BaseTrackerRejection>(new MassExpiryRejection(*this));
+  }
+
+  void resetFrom(const BaseTrackerRejection& prototype) override {
+    *this = dynamic_cast<const MassExpiryRejection&>(prototype);
+  }
+
+ private:
+  int iterations_without_update_ = 0;
+};
+}  // namespace
+
+int main(int ac, char** av) {
+  std::vector<Eigen::VectorXd> measurements;
+  for (int i = 0; i < TRACKS; ++i) {
+    measurements.push_back(Eigen::Vector2d(i, 0.0));
+  }
+  Eigen::VectorXi new_tracks = Eigen::VectorXi::Constant(TRACKS,
+      laser_object_tracker::data_association::BaseDataAssociation::NO_ASSIGNMENT);
+  Eigen::VectorXi no_measurements;
+
+  laser_object_tracker::tracking::MultiTracker multi_tracker(
+      [](const Eigen::VectorXd& measurement, const BaseTracking& tracker) {
+        return (measurement - tracker.getStateVector()).squaredNorm();
+      },
+      std::make_unique<laser_object_tracker::data_association::HungarianAlgorithm>(),
+      std::make_unique<PositionTracking>(),
+      std::make_unique<MassExpiryRejection>());
+  multi_tracker.reserve(TRACKS);
+
+  std::chrono::duration<double, std::micro> initialization(0.0), expiry(0.0);
+  for (int i = 0; i < REPETITIONS; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    multi_tracker.updateAndInitializeTracks(measurements, new_tracks);
+    auto middle = std::chrono::steady_clock::now();
+    multi_tracker.handleNotUpdatedTracks(no_measurements);
+    multi_tracker.handleRejectedTracks();
+    auto end = std::chrono::steady_clock::now();
+
+    initialization += middle - start;
+    expiry += end - middle;
+
+    // Remove survivors, so that every repetition starts from an empty tracker
+    multi_tracker.handleNotUpdatedTracks(no_measurements);
+    multi_tracker.handleRejectedTracks();
+  }
+
+  std::cout << "Tracks: " << TRACKS << "\n"
+            << "Initialization: " << initialization.count() / REPETITIONS << " us\n"
+            << "Not updated and rejected tracks handling: " << expiry.count() / REPETITIONS << " us\n";
+
+  return 0;
+}
@@ -0,0 +1,81 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include "laser_object_tracker/data_association/hungarian_algorithm.hpp"
+#include "laser_object_tracker/data_association/murty_algorithm.hpp"
+
+namespace {
+constexpr int SIZE = 50;
+constexpr int MAX_K = 100;
+constexpr int REPETITIONS = 20;
+}  // namespace
+
+int main(int ac, char** av) {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> distribution(0.0, 10.0);
+
+  std::vector<Eigen::MatrixXd> cost_matrices;
+  for (int i = 0; i < REPETITIONS; ++i) {
+    cost_matrices.push_back(Eigen::MatrixXd::NullaryExpr(SIZE, SIZE, [&]() {
+      return distribution(generator);
+    }));
+  }
+
+  laser_object_tracker::data_association::HungarianAlgorithm hungarian_algorithm;
+  Eigen::VectorXi assignment_vector;
+  auto start = std::chrono::steady_clock::now();
+  for (const auto& cost_matrix : cost_matrices) {
+    hungarian_algorithm.solve(cost_matrix, hungarian_algorithm.NOT_NEEDED, assignment_vector);
+  }
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "HungarianAlgorithm " << SIZE << "x" << SIZE << ": " << elapsed.count() / REPETITIONS << " us\n";
+
+  laser_object_tracker::data_association::MurtyAlgorithm murty_algorithm;
+  std::vector<Eigen::VectorXi> assignment_vectors;
+  std::vector<double> costs;
+  std::cout << "k,murty_us\n";
+  for (int k = 1; k <= MAX_K; ++k) {
+    start = std::chrono::steady_clock::now();
+    for (const auto& cost_matrix : cost_matrices) {
+      murty_algorithm.solveKBest(cost_matrix, k, assignment_vectors, costs);
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << k << "," << elapsed.count() / REPETITIONS << "\n";
+  }
+
+  return 0;
+}
@@ -40,7 +40,7 @@
 
 namespace test {
 class MockDataAssociation : public laser_object_tracker::data_association::BaseDataAssociation {
-  MOCK_METHOD3(solve, double(const Eigen::MatrixXd& cost_matrix,
+  MOCK_METHOD3(solve, double(const CostMatrix& cost_matrix,
       const Eigen::MatrixXd& covariance_matrix,
       Eigen::VectorXi& assignment_vector));
 };
@@ -36,6 +36,7 @@
 
 #include <gmock/gmock.h>
 
+#include "laser_object_tracker/tracking/base_tracker_rejection.hpp"
 #include "laser_object_tracker/tracking/base_tracking.hpp"
 
 namespace test {
@@ -51,10 +52,14 @@ class MockTracking : public laser_object_tracker::tracking::BaseTracking {
 
   MOCK_METHOD0(predict, void());
 
+  MOCK_METHOD1(predict, void(double));
+
   MOCK_METHOD1(update, void(const Eigen::VectorXd&));
 
   MOCK_CONST_METHOD0(getStateVector, Eigen::VectorXd());
 
+  MOCK_METHOD1(resetFrom, void(const BaseTracking&));
+
   std::unique_ptr<BaseTracking> clone() const override {
     return std::unique_ptr<BaseTracking>(new MockTracking());
   }
@@ -63,6 +68,8 @@ class MockTracking : public laser_object_tracker::tracking::BaseTracking {
 class MockTrackerRejection : public laser_object_tracker::tracking::BaseTrackerRejection {
   MOCK_CONST_METHOD1(invalidate, bool(const laser_object_tracker::tracking::BaseTracking& tracker));
 
+  MOCK_METHOD1(resetFrom, void(const BaseTrackerRejection& prototype));
+
   std::unique_ptr<BaseTrackerRejection> clone() const override {
     return std::unique_ptr<BaseTrackerRejection>(new MockTrackerRejection());
   }
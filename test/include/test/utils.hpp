@@ -78,6 +78,20 @@ inline laser_object_tracker::data_types::LaserScanType generateLaserScan(
   return laser_scan;
 }
 
+/**
+ * @brief Scan of an L-shape with corner at (1, 1) and arms along x = 1 and y = 1, ending at (1, -1) and (-1, 1),
+ * rotated around the sensor by the given angle.
+ */
+inline laser_object_tracker::data_types::LaserScanType generateLShapeScan(int beams, double rotation = 0.0) {
+  std::vector<float> ranges;
+  for (int i = 0; i < beams; ++i) {
+    double angle = -M_PI_4 + i * M_PI / (beams - 1);
+    ranges.push_back(angle <= M_PI_4 ? 1.0 / std::cos(angle) : 1.0 / std::sin(angle));
+  }
+
+  return generateLaserScan(ranges, -M_PI_4 + rotation, 3.0 * M_PI_4 + rotation);
+}
+
 template<class T>
 constexpr static T PRECISION = T(0.0001);
 
@@ -0,0 +1,71 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "laser_object_tracker/data_association/murty_algorithm.hpp"
+
+#include "test/allocation_counter.hpp"
+
+TEST(MurtyAlgorithmAllocationTest, SteadyStateTest) {
+  constexpr int SIZE = 50;
+  constexpr int K = 10;
+  constexpr int REPETITIONS = 5;
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> distribution(0.0, 10.0);
+
+  std::vector<Eigen::MatrixXd> cost_matrices;
+  for (int i = 0; i < REPETITIONS; ++i) {
+    cost_matrices.push_back(Eigen::MatrixXd::NullaryExpr(SIZE, SIZE, [&]() {
+      return distribution(generator);
+    }));
+  }
+
+  laser_object_tracker::data_association::MurtyAlgorithm murty_algorithm;
+  std::vector<Eigen::VectorXi> assignment_vectors;
+  std::vector<double> costs;
+  for (const auto& cost_matrix : cost_matrices) {
+    murty_algorithm.solveKBest(cost_matrix, K, assignment_vectors, costs);
+  }
+
+  // Once warm only returned assignment vectors are allocated, subproblems are not copied
+  long before = test::allocations();
+  for (const auto& cost_matrix : cost_matrices) {
+    murty_algorithm.solveKBest(cost_matrix, K, assignment_vectors, costs);
+    EXPECT_EQ(K, assignment_vectors.size());
+  }
+  EXPECT_GE(REPETITIONS * (K + 1), test::allocations() - before);
+}
@@ -0,0 +1,244 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "laser_object_tracker/data_association/hungarian_algorithm.hpp"
+#include "laser_object_tracker/data_association/murty_algorithm.hpp"
+
+#include "test/utils.hpp"
+
+namespace {
+using laser_object_tracker::data_association::BaseDataAssociation;
+
+double assignmentCost(const Eigen::MatrixXd& cost_matrix, const Eigen::VectorXi& assignment_vector) {
+  double cost = 0.0;
+  for (int col = 0; col < assignment_vector.size(); ++col) {
+    if (assignment_vector(col) != BaseDataAssociation::NO_ASSIGNMENT) {
+      cost += cost_matrix(assignment_vector(col), col);
+    }
+  }
+  return cost;
+}
+
+std::vector<double> bruteForceCosts(const Eigen::MatrixXd& cost_matrix) {
+  // Permute the larger dimension and assign its first elements to the smaller one
+  bool transposed = cost_matrix.rows() > cost_matrix.cols();
+  Eigen::MatrixXd matrix = transposed ? Eigen::MatrixXd(cost_matrix.transpose()) : cost_matrix;
+
+  std::vector<int> permutation(matrix.cols());
+  std::iota(permutation.begin(), permutation.end(), 0);
+
+  std::vector<double> costs;
+  std::vector<std::vector<int>> visited;
+  do {
+    std::vector<int> used(permutation.begin(), permutation.begin() + matrix.rows());
+    if (std::find(visited.begin(), visited.end(), used) != visited.end()) {
+      continue;
+    }
+    visited.push_back(used);
+
+    double cost = 0.0;
+    for (int row = 0; row < matrix.rows(); ++row) {
+      cost += matrix(row, used.at(row));
+    }
+    costs.push_back(cost);
+  } while (std::next_permutation(permutation.begin(), permutation.end()));
+
+  std::sort(costs.begin(), costs.end());
+  return costs;
+}
+}  // namespace
+
+TEST(MurtyAlgorithmTest, EmptyMatrixTest) {
+  laser_object_tracker::data_association::MurtyAlgorithm murty_algorithm;
+
+  Eigen::MatrixXd cost_matrix;
+  std::vector<Eigen::VectorXi> assignment_vectors;
+  std::vector<double> costs;
+  murty_algorithm.solveKBest(cost_matrix, 5, assignment_vectors, costs);
+
+  ASSERT_EQ(1, assignment_vectors.size());
+  ASSERT_EQ(1, costs.size());
+  EXPECT_EQ(Eigen::VectorXi(), assignment_vectors.front());
+  EXPECT_NEAR(0.0, costs.front(), test::PRECISION<double>);
+}
+
+TEST(MurtyAlgorithmTest, InvalidNumberOfAssignmentsTest) {
+  laser_object_tracker::data_association::MurtyAlgorithm murty_algorithm;
+  laser_object_tracker::data_association::HungarianAlgorithm hungarian_algorithm;
+
+  Eigen::MatrixXd cost_matrix = Eigen::MatrixXd::Ones(2, 2);
+  std::vector<Eigen::VectorXi> assignment_vectors;
+  std::vector<double> costs;
+  EXPECT_THROW(murty_algorithm.solveKBest(cost_matrix, 0, assignment_vectors, costs), std::invalid_argument);
+  EXPECT_THROW(hungarian_algorithm.solveKBest(cost_matrix, -1, assignment_vectors, costs), std::invalid_argument);
+}
+
+TEST(MurtyAlgorithmTest, SameAsHungarianTest) {
+  laser_object_tracker::data_association::MurtyAlgorithm murty_algorithm(50.0);
+  laser_object_tracker::data_association::HungarianAlgorithm hungarian_algorithm(50.0);
+
+  std::vector<Eigen::MatrixXd> cost_matrices(3);
+  cost_matrices.at(0).resize(4, 4);
+  cost_matrices.at(0) << 21.0, 49.0, 14.0, 45.0,
+                         30.0, 21.0, 67.0,  7.0,
+                         26.0, 39.0, 66.0, 72.0,
+                          6.0, 40.0, 54.0, 43.0;
+  cost_matrices.at(1).resize(5, 4);
+  cost_matrices.at(1) <<  2.0, 42.0, 25.0,  7.0,
+                         50.0, 27.0, 39.0, 27.0,
+                         50.0, 89.0, 68.0, 10.0,
+                         91.0,  6.0, 76.0, 81.0,
+                         21.0, 35.0, 86.0, 23.0;
+  cost_matrices.at(2).resize(3, 4);
+  cost_matrices.at(2) << 20.0, 81.0, 44.0,  9.0,
+                         85.0,  3.0, 11.0, 93.0,
+                         29.0,  3.0, 39.0, 47.0;
+
+  Eigen::VectorXi murty_assignment, hungarian_assignment;
+  for (const auto& cost_matrix : cost_matrices) {
+    double hungarian_cost = hungarian_algorithm.solve(cost_matrix, hungarian_algorithm.NOT_NEEDED, hungarian_assignment);
+    double murty_cost = murty_algorithm.solve(cost_matrix, murty_algorithm.NOT_NEEDED, murty_assignment);
+    EXPECT_NEAR(hungarian_cost, murty_cost, test::PRECISION<double>);
+    EXPECT_EQ(hungarian_assignment, murty_assignment);
+  }
+}
+
+TEST(MurtyAlgorithmTest, KBestTest) {
+  laser_object_tracker::data_association::MurtyAlgorithm murty_algorithm;
+
+  Eigen::MatrixXd cost_matrix(3, 3);
+  cost_matrix << 1.0, 2.0, 9.0,
+                 2.0, 1.0, 9.0,
+                 9.0, 9.0, 1.0;
+  std::vector<Eigen::VectorXi> assignment_vectors;
+  std::vector<double> costs;
+  murty_algorithm.solveKBest(cost_matrix, 3, assignment_vectors, costs);
+
+  ASSERT_EQ(3, assignment_vectors.size());
+  ASSERT_EQ(3, costs.size());
+
+  Eigen::VectorXi expected_assignment(3);
+  expected_assignment << 0, 1, 2;
+  EXPECT_EQ(expected_assignment, assignment_vectors.at(0));
+  EXPECT_NEAR(3.0, costs.at(0), test::PRECISION<double>);
+
+  expected_assignment << 1, 0, 2;
+  EXPECT_EQ(expected_assignment, assignment_vectors.at(1));
+  EXPECT_NEAR(5.0, costs.at(1), test::PRECISION<double>);
+
+  EXPECT_NEAR(19.0, costs.at(2), test::PRECISION<double>);
+}
+
+TEST(MurtyAlgorithmTest, BruteForceTest) {
+  laser_object_tracker::data_association::MurtyAlgorithm murty_algorithm;
+
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> distribution(0.0, 10.0);
+  std::vector<std::pair<int, int>> sizes = {{1, 1}, {1, 4}, {4, 1}, {5, 5}, {4, 6}, {6, 4}, {6, 6}};
+
+  for (const auto& size : sizes) {
+    Eigen::MatrixXd cost_matrix = Eigen::MatrixXd::NullaryExpr(size.first, size.second, [&]() {
+      return distribution(generator);
+    });
+    std::vector<double> expected_costs = bruteForceCosts(cost_matrix);
+
+    std::vector<Eigen::VectorXi> assignment_vectors;
+    std::vector<double> costs;
+    murty_algorithm.solveKBest(cost_matrix, 50, assignment_vectors, costs);
+
+    ASSERT_EQ(std::min<size_t>(50, expected_costs.size()), costs.size());
+    ASSERT_EQ(costs.size(), assignment_vectors.size());
+    for (int i = 0; i < costs.size(); ++i) {
+      EXPECT_NEAR(expected_costs.at(i), costs.at(i), test::PRECISION<double>);
+      EXPECT_NEAR(costs.at(i), assignmentCost(cost_matrix, assignment_vectors.at(i)), test::PRECISION<double>);
+      EXPECT_EQ(std::min(size.first, size.second),
+                (assignment_vectors.at(i).array() != BaseDataAssociation::NO_ASSIGNMENT).count());
+      for (int j = 0; j < i; ++j) {
+        EXPECT_NE(assignment_vectors.at(j), assignment_vectors.at(i));
+      }
+    }
+  }
+}
+
+TEST(MurtyAlgorithmTest, MaxAllowedCostTest) {
+  laser_object_tracker::data_association::MurtyAlgorithm murty_algorithm(5.0);
+
+  Eigen::MatrixXd cost_matrix(2, 2);
+  cost_matrix << 1.0, 10.0,
+                 10.0, 8.0;
+  std::vector<Eigen::VectorXi> assignment_vectors;
+  std::vector<double> costs;
+  murty_algorithm.solveKBest(cost_matrix, 2, assignment_vectors, costs);
+
+  // Pairs above max allowed cost are removed from returned assignments and their costs
+  ASSERT_EQ(2, assignment_vectors.size());
+  Eigen::VectorXi expected_assignment(2);
+  expected_assignment << 0, BaseDataAssociation::NO_ASSIGNMENT;
+  EXPECT_EQ(expected_assignment, assignment_vectors.at(0));
+  EXPECT_NEAR(1.0, costs.at(0), test::PRECISION<double>);
+  expected_assignment << BaseDataAssociation::NO_ASSIGNMENT, BaseDataAssociation::NO_ASSIGNMENT;
+  EXPECT_EQ(expected_assignment, assignment_vectors.at(1));
+  EXPECT_NEAR(0.0, costs.at(1), test::PRECISION<double>);
+
+  cost_matrix << 1.0, 10.0,
+                 10.0, 1.0;
+  murty_algorithm.setMaxAllowedCost(0.5);
+  murty_algorithm.solveKBest(cost_matrix, 2, assignment_vectors, costs);
+
+  // Both complete assignments become empty, duplicate is not returned
+  ASSERT_EQ(1, assignment_vectors.size());
+  EXPECT_EQ(expected_assignment, assignment_vectors.at(0));
+}
+
+TEST(MurtyAlgorithmTest, DefaultKBestTest) {
+  laser_object_tracker::data_association::HungarianAlgorithm hungarian_algorithm;
+
+  Eigen::MatrixXd cost_matrix(2, 2);
+  cost_matrix << 1.0, 2.0,
+                 2.0, 1.0;
+  std::vector<Eigen::VectorXi> assignment_vectors;
+  std::vector<double> costs;
+  hungarian_algorithm.solveKBest(cost_matrix, 2, assignment_vectors, costs);
+
+  ASSERT_EQ(1, assignment_vectors.size());
+  Eigen::VectorXi expected_assignment(2);
+  expected_assignment << 0, 1;
+  EXPECT_EQ(expected_assignment, assignment_vectors.front());
+  EXPECT_NEAR(2.0, costs.front(), test::PRECISION<double>);
+}
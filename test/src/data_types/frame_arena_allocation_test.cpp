@@ -0,0 +1,90 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "laser_object_tracker/data_association/hungarian_algorithm.hpp"
+#include "laser_object_tracker/data_types/frame_arena.hpp"
+
+#include "test/allocation_counter.hpp"
+
+using laser_object_tracker::data_types::FrameArena;
+
+TEST(FrameArenaAllocationTest, SteadyStateGrowthTest) {
+  FrameArena arena;
+  for (int i = 0; i < 4; ++i) {
+    arena.allocate<double>(100);
+  }
+  arena.reset();
+
+  long before = test::allocations();
+  for (int frame = 0; frame < 10; ++frame) {
+    for (int i = 0; i < 4; ++i) {
+      arena.allocate<double>(100);
+    }
+    arena.reset();
+  }
+  EXPECT_EQ(before, test::allocations());
+}
+
+TEST(FrameArenaAllocationTest, SteadyStateAssociationTest) {
+  constexpr int MEASUREMENTS = 20;
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> distribution(0.0, 10.0);
+  std::uniform_int_distribution<int> tracks_distribution(1, 30);
+
+  FrameArena arena;
+  laser_object_tracker::data_association::HungarianAlgorithm hungarian_algorithm;
+  Eigen::VectorXi assignment_vector;
+
+  auto frame = [&](int tracks) {
+    Eigen::Map<Eigen::MatrixXd> cost_matrix(arena.allocate<double>(tracks * MEASUREMENTS), tracks, MEASUREMENTS);
+    for (int i = 0; i < cost_matrix.size(); ++i) {
+      cost_matrix(i) = distribution(generator);
+    }
+    hungarian_algorithm.solve(cost_matrix, hungarian_algorithm.NOT_NEEDED, assignment_vector);
+    arena.reset();
+  };
+
+  // Warm-up with the largest problem
+  frame(30);
+  frame(30);
+
+  long before = test::allocations();
+  for (int i = 0; i < 100; ++i) {
+    frame(tracks_distribution(generator));
+  }
+  EXPECT_EQ(before, test::allocations());
+}
@@ -0,0 +1,70 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "laser_object_tracker/data_types/frame_arena.hpp"
+
+using laser_object_tracker::data_types::FrameArena;
+
+TEST(FrameArenaTest, AllocateAndResetTest) {
+  FrameArena arena(64);
+  EXPECT_EQ(64, arena.capacity());
+  EXPECT_EQ(0, arena.used());
+
+  char* first = arena.allocate<char>(3);
+  double* second = arena.allocate<double>(2);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(second) % alignof(double));
+  EXPECT_LE(reinterpret_cast<char*>(first + 3), reinterpret_cast<char*>(second));
+  EXPECT_EQ(24, arena.used());
+
+  arena.reset();
+  EXPECT_EQ(0, arena.used());
+  EXPECT_EQ(first, arena.allocate<char>(1));
+}
+
+TEST(FrameArenaTest, GrowthTest) {
+  FrameArena arena;
+  EXPECT_EQ(0, arena.capacity());
+
+  // Frame which does not fit still gets valid memory, and the block grows to fit it on reset
+  for (int i = 0; i < 4; ++i) {
+    double* values = arena.allocate<double>(100);
+    std::fill(values, values + 100, i);
+  }
+  EXPECT_EQ(0, arena.used());
+  arena.reset();
+  EXPECT_LE(4 * 100 * sizeof(double), arena.capacity());
+}
@@ -93,6 +93,41 @@ TEST_F(LaserScanFragmentTest, SubrangeConstructorExceptionsTest) {
   EXPECT_THROW(laser_object_tracker::data_types::LaserScanFragment(fragment, 4, 0), std::invalid_argument);
 }
 
+TEST_F(LaserScanFragmentTest, JoiningConstructorTest) {
+  auto fragment = factory_.fromLaserScan(test::getFragmentUnique2().laser_scan_);
+  laser_object_tracker::data_types::LaserScanFragment first(fragment, 1, 3);
+  laser_object_tracker::data_types::LaserScanFragment neighbour(fragment, 3, 5);
+  laser_object_tracker::data_types::LaserScanFragment separated(fragment, 7, 9);
+
+  // Neighbouring fragments form a sub-range
+  laser_object_tracker::data_types::LaserScanFragment result({&first, &neighbour});
+  EXPECT_TRUE(result.hasEvenlySpacedAngles());
+  EXPECT_EQ(laser_object_tracker::data_types::LaserScanFragment(fragment, 1, 5), result);
+
+  // Elements of separated fragments keep their angles
+  result = laser_object_tracker::data_types::LaserScanFragment({&first, &neighbour, &separated});
+  EXPECT_FALSE(result.hasEvenlySpacedAngles());
+  ASSERT_EQ(6, result.size());
+  EXPECT_EQ(6, result.laserScan().ranges.size());
+  EXPECT_DOUBLE_EQ(fragment[1].getAngle(), result.getAngleMin());
+  EXPECT_DOUBLE_EQ(fragment[8].getAngle(), result.getAngleMax());
+  std::vector<long> indices{1, 2, 3, 4, 7, 8};
+  for (int i = 0; i < indices.size(); ++i) {
+    EXPECT_EQ(fragment[indices[i]], result[i]);
+  }
+
+  // Angles are carried over by copies and sub-ranges
+  auto copy = result;
+  EXPECT_DOUBLE_EQ(fragment[7].getAngle(), copy[4].getAngle());
+  laser_object_tracker::data_types::LaserScanFragment sub_range(result, 3, 6);
+  EXPECT_FALSE(sub_range.hasEvenlySpacedAngles());
+  EXPECT_DOUBLE_EQ(fragment[4].getAngle(), sub_range.getAngleMin());
+  EXPECT_DOUBLE_EQ(fragment[7].getAngle(), sub_range[1].getAngle());
+
+  EXPECT_THROW(laser_object_tracker::data_types::LaserScanFragment(
+      std::vector<const laser_object_tracker::data_types::LaserScanFragment*>()), std::invalid_argument);
+}
+
 TEST_P(LaserScanFragmentTestWithParam, AccessorTest) {
   test::ReferenceFragment reference = GetParam();
   auto fragment = factory_.fromLaserScan(reference.laser_scan_);
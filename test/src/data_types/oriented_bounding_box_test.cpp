@@ -0,0 +1,243 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include "laser_object_tracker/data_types/oriented_bounding_box.hpp"
+
+#include "test/utils.hpp"
+
+using namespace laser_object_tracker::data_types;
+
+namespace {
+bool contains(const OrientedBoundingBox& obb, const cv::Point2f& point) {
+  double dx = point.x - obb.center(0), dy = point.y - obb.center(1);
+  double along = dx * std::cos(obb.angle) + dy * std::sin(obb.angle);
+  double across = dy * std::cos(obb.angle) - dx * std::sin(obb.angle);
+  return std::abs(along) <= obb.size(0) / 2.0 + 1e-4 && std::abs(across) <= obb.size(1) / 2.0 + 1e-4;
+}
+
+/**
+ * @brief Minimal area box in double precision, trying directions through every pair of points, which include all hull
+ * edges.
+ * @return Area and length of the longer side of the box
+ */
+std::pair<double, double> bruteForceBox(const std::vector<cv::Point2f>& points) {
+  std::pair<double, double> best(std::numeric_limits<double>::infinity(), 0.0);
+  for (size_t i = 0; i < points.size(); ++i) {
+    for (size_t j = i + 1; j < points.size(); ++j) {
+      Eigen::Vector2d direction(static_cast<double>(points[j].x) - points[i].x,
+                                static_cast<double>(points[j].y) - points[i].y);
+      if (direction.isZero()) {
+        continue;
+      }
+      direction.normalize();
+
+      double min_along = 0.0, max_along = 0.0, min_across = 0.0, max_across = 0.0;
+      for (const auto& point : points) {
+        Eigen::Vector2d offset(static_cast<double>(point.x) - points[i].x, static_cast<double>(point.y) - points[i].y);
+        double along = offset.dot(direction), across = direction.x() * offset.y() - direction.y() * offset.x();
+        min_along = std::min(min_along, along);
+        max_along = std::max(max_along, along);
+        min_across = std::min(min_across, across);
+        max_across = std::max(max_across, across);
+      }
+
+      double area = (max_along - min_along) * (max_across - min_across);
+      if (area < best.first) {
+        best = {area, std::max(max_along - min_along, max_across - min_across)};
+      }
+    }
+  }
+
+  return best;
+}
+}  // namespace
+
+TEST(OrientedBoundingBoxTest, EmptyTest) {
+  OrientedBoundingBoxCalculator calculator;
+  OrientedBoundingBox obb;
+  obb.size << 1.0, 1.0;
+  calculator.compute(obb);
+
+  EXPECT_DOUBLE_EQ(0.0, obb.area());
+  EXPECT_TRUE(obb.center.isZero());
+}
+
+TEST(OrientedBoundingBoxTest, SinglePointTest) {
+  OrientedBoundingBoxCalculator calculator;
+  calculator.addPoint(1.0f, 2.0f);
+  calculator.addPoint(1.0f, 2.0f);
+
+  OrientedBoundingBox obb;
+  calculator.compute(obb);
+
+  EXPECT_DOUBLE_EQ(0.0, obb.area());
+  EXPECT_NEAR(1.0, obb.center(0), test::PRECISION<double>);
+  EXPECT_NEAR(2.0, obb.center(1), test::PRECISION<double>);
+}
+
+TEST(OrientedBoundingBoxTest, CollinearTest) {
+  OrientedBoundingBoxCalculator calculator;
+  for (int i = 0; i < 5; ++i) {
+    calculator.addPoint(1.0f + i, 3.0f - i);
+  }
+
+  OrientedBoundingBox obb;
+  calculator.compute(obb);
+
+  EXPECT_NEAR(4.0 * std::sqrt(2.0), obb.size(0), test::PRECISION<double>);
+  EXPECT_NEAR(0.0, obb.size(1), test::PRECISION<double>);
+  EXPECT_NEAR(3.0, obb.center(0), test::PRECISION<double>);
+  EXPECT_NEAR(1.0, obb.center(1), test::PRECISION<double>);
+  EXPECT_NEAR(-M_PI_4, obb.angle, test::PRECISION<double>);
+}
+
+TEST(OrientedBoundingBoxTest, LShapeTest) {
+  OrientedBoundingBoxCalculator calculator;
+  // Corner of a box seen from the origin, with sides rotated by 30 degrees
+  const double angle = M_PI / 6.0;
+  Eigen::Vector2d corner(5.0, 1.0), side_1(std::cos(angle), std::sin(angle)), side_2(-std::sin(angle), std::cos(angle));
+  std::vector<cv::Point2f> points;
+  for (int i = 10; i > 0; --i) {
+    Eigen::Vector2d point = corner - side_1 * 0.2 * i;
+    points.emplace_back(point.x(), point.y());
+  }
+  for (int i = 0; i <= 5; ++i) {
+    Eigen::Vector2d point = corner + side_2 * 0.2 * i;
+    points.emplace_back(point.x(), point.y());
+  }
+  for (const auto& point : points) {
+    calculator.addPoint(point.x, point.y);
+  }
+
+  OrientedBoundingBox obb;
+  calculator.compute(obb);
+
+  EXPECT_NEAR(2.0, obb.area(), test::PRECISION<double>);
+  for (const auto& point : points) {
+    EXPECT_TRUE(contains(obb, point));
+  }
+}
+
+TEST(OrientedBoundingBoxTest, OpenCVEquivalenceTest) {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<float> range_distribution(1.0f, 10.0f), noise_distribution(-0.05f, 0.05f);
+  std::uniform_int_distribution<int> size_distribution(3, 60);
+
+  OrientedBoundingBoxCalculator calculator;
+  for (int trial = 0; trial < 200; ++trial) {
+    int size = size_distribution(generator);
+    float bearing = range_distribution(generator), range = range_distribution(generator);
+
+    calculator.clear();
+    std::vector<cv::Point2f> points;
+    for (int i = 0; i < size; ++i) {
+      float point_range = range + noise_distribution(generator) * 10.0f;
+      float point_bearing = bearing + 0.01f * i;
+      points.emplace_back(point_range * std::cos(point_bearing), point_range * std::sin(point_bearing));
+      calculator.addPoint(points.back().x, points.back().y);
+    }
+
+    OrientedBoundingBox obb;
+    calculator.compute(obb);
+    auto rectangle = cv::minAreaRect(points);
+
+    // Boxes of nearly equal area may differ in orientation, so only the area and containment are compared
+    EXPECT_NEAR(rectangle.size.area(), obb.area(), 1e-3 * rectangle.size.area());
+    for (const auto& point : points) {
+      EXPECT_TRUE(contains(obb, point));
+    }
+  }
+}
+
+TEST(OrientedBoundingBoxTest, NearlyCollinearTest) {
+  // Orientation of the first points is below float precision, so they used to be dropped from the hull
+  std::vector<cv::Point2f> points{
+      {-5.1726284f, 0.681048512f}, {-4.00920963f, 0.00822417252f}, {-3.91992426f, -0.0434110388f},
+      {-3.78763962f, -0.119913444f}, {-2.78895044f, -0.697471857f}, {-2.29509497f, -0.983076632f},
+      {-1.3654213f, -1.52072227f}, {7.50565863f, -6.60795641f}};
+  OrientedBoundingBoxCalculator calculator;
+  for (const auto& point : points) {
+    calculator.addPoint(point.x, point.y);
+  }
+
+  OrientedBoundingBox obb;
+  calculator.compute(obb);
+
+  auto expected = bruteForceBox(points);
+  EXPECT_NEAR(expected.first, obb.area(), 1e-4 * expected.first);
+  EXPECT_NEAR(expected.second, std::max(obb.size(0), obb.size(1)), 1e-4);
+  for (const auto& point : points) {
+    EXPECT_TRUE(contains(obb, point));
+  }
+}
+
+TEST(OrientedBoundingBoxTest, StraightWallTest) {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> distance_distribution(1.0, 10.0), angle_distribution(-M_PI, M_PI);
+  std::uniform_real_distribution<double> noise_distribution(-0.001, 0.001);
+  std::uniform_int_distribution<int> size_distribution(3, 60);
+
+  OrientedBoundingBoxCalculator calculator;
+  for (int trial = 0; trial < 2000; ++trial) {
+    // Wall with normal at the given bearing, seen by beams ordered by bearing
+    const double distance = distance_distribution(generator), normal = angle_distribution(generator);
+    const int size = size_distribution(generator);
+    const double first_bearing = normal - 0.005 * size / 2.0;
+    const double noise = trial % 2 == 0 ? 0.0 : 1.0;
+
+    calculator.clear();
+    std::vector<cv::Point2f> points;
+    for (int i = 0; i < size; ++i) {
+      double bearing = first_bearing + 0.005 * i;
+      double range = distance / std::cos(bearing - normal) + noise * noise_distribution(generator);
+      points.emplace_back(range * std::cos(bearing), range * std::sin(bearing));
+      calculator.addPoint(points.back().x, points.back().y);
+    }
+
+    OrientedBoundingBox obb;
+    calculator.compute(obb);
+
+    auto expected = bruteForceBox(points);
+    EXPECT_NEAR(expected.first, obb.area(), 1e-3 * expected.first + 1e-9) << "Trial " << trial;
+    EXPECT_NEAR(expected.second, std::max(obb.size(0), obb.size(1)), 1e-4) << "Trial " << trial;
+  }
+}
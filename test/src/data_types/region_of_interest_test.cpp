@@ -0,0 +1,125 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "laser_object_tracker/data_types/region_of_interest.hpp"
+#include "laser_object_tracker/data_types/laser_scan_fragment.hpp"
+
+#include "test/utils.hpp"
+
+using namespace laser_object_tracker::data_types;
+
+TEST(RegionOfInterestTest, AccessorsTest) {
+  RegionOfInterest region;
+  EXPECT_TRUE(region.isUnbounded());
+
+  region.addAngleWindow(-0.5, 0.5);
+  ASSERT_EQ(1, region.getAngleWindows().size());
+  EXPECT_FALSE(region.isUnbounded());
+
+  region.setRangeLimits(0.5, 15.0);
+  EXPECT_NEAR(0.5, region.getMinRange(), test::PRECISION<double>);
+  EXPECT_NEAR(15.0, region.getMaxRange(), test::PRECISION<double>);
+
+  EXPECT_THROW(region.addAngleWindow(1.0, 0.0), std::invalid_argument);
+  EXPECT_THROW(region.setRangeLimits(-1.0, 1.0), std::invalid_argument);
+  EXPECT_THROW(region.setRangeLimits(2.0, 1.0), std::invalid_argument);
+  EXPECT_THROW(region.setPolygon({Eigen::Vector2d(0.0, 0.0), Eigen::Vector2d(1.0, 0.0)}), std::invalid_argument);
+}
+
+TEST(RegionOfInterestTest, ContainsTest) {
+  RegionOfInterest region;
+  region.addAngleWindow(-1.0, -0.5);
+  region.addAngleWindow(0.5, 1.0);
+  EXPECT_TRUE(region.containsAngle(-0.7));
+  EXPECT_TRUE(region.containsAngle(1.0));
+  EXPECT_FALSE(region.containsAngle(0.0));
+
+  region.setRangeLimits(1.0, 2.0);
+  EXPECT_TRUE(region.containsRange(1.5));
+  EXPECT_FALSE(region.containsRange(0.5));
+  EXPECT_FALSE(region.containsRange(std::numeric_limits<double>::quiet_NaN()));
+
+  // Concave polygon, notch from (1, 1) reaches down to (1, 0.5)
+  region.setPolygon({Eigen::Vector2d(0.0, 0.0), Eigen::Vector2d(2.0, 0.0), Eigen::Vector2d(2.0, 1.0),
+                     Eigen::Vector2d(1.0, 0.5), Eigen::Vector2d(0.0, 1.0)});
+  EXPECT_TRUE(region.containsPoint(Eigen::Vector2d(0.5, 0.5)));
+  EXPECT_TRUE(region.containsPoint(Eigen::Vector2d(1.0, 0.25)));
+  EXPECT_FALSE(region.containsPoint(Eigen::Vector2d(1.0, 0.75)));
+  EXPECT_FALSE(region.containsPoint(Eigen::Vector2d(3.0, 0.5)));
+}
+
+TEST(RegionOfInterestTest, FragmentFactoryTest) {
+  RegionOfInterest region;
+  region.addAngleWindow(-M_PI_2 - 0.01, M_PI_2 + 0.01);
+  region.setRangeLimits(0.0, 3.0);
+
+  // Beams every pi/4 from -pi, those at -pi, -3pi/4, 3pi/4 and pi are out of the window, one more is too far
+  auto laser_scan = test::generateLaserScan({1.0, 1.0, 1.0, 1.0, 5.0, 1.0, 1.0, 1.0, 1.0});
+  auto cropped_scan = laser_scan;
+  EXPECT_EQ(4, region.apply(cropped_scan));
+
+  LaserScanFragment::LaserScanFragmentFactory factory;
+  factory.setRegionOfInterest(region);
+  EXPECT_EQ(1, factory.getRegionOfInterest().getAngleWindows().size());
+
+  auto fragment = factory.fromLaserScan(laser_scan);
+  ASSERT_EQ(laser_scan.ranges.size(), fragment.size());
+  std::vector<bool> expected_valid{false, false, true, true, false, true, true, false, false};
+  for (int i = 0; i < fragment.size(); ++i) {
+    EXPECT_EQ(expected_valid.at(i), fragment.at(i).isValid()) << "Beam " << i;
+    // Angles of kept beams are not shifted
+    EXPECT_NEAR(-M_PI + i * M_PI_4, fragment.at(i).getAngle(), test::PRECISION<double>);
+  }
+}
+
+TEST(RegionOfInterestTest, InvalidRangesTest) {
+  RegionOfInterest region;
+  region.addAngleWindow(-M_PI_2 - 0.01, M_PI_2 + 0.01);
+
+  // Invalid returns out of the window keep their values, the valid one out of the window is excluded
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  auto laser_scan = test::generateLaserScan({0.1, nan, 12.0, 1.0, 0.1, 1.0, nan, 12.0, 1.0}, -M_PI, M_PI, "", 0.5);
+  EXPECT_EQ(2, region.apply(laser_scan));
+
+  EXPECT_FLOAT_EQ(0.1f, laser_scan.ranges.at(0));
+  EXPECT_TRUE(std::isnan(laser_scan.ranges.at(1)));
+  EXPECT_FLOAT_EQ(12.0f, laser_scan.ranges.at(2));
+  EXPECT_FLOAT_EQ(1.0f, laser_scan.ranges.at(3));
+  EXPECT_FLOAT_EQ(0.1f, laser_scan.ranges.at(4));
+  EXPECT_FLOAT_EQ(1.0f, laser_scan.ranges.at(5));
+  EXPECT_TRUE(std::isnan(laser_scan.ranges.at(6)));
+  EXPECT_FLOAT_EQ(12.0f, laser_scan.ranges.at(7));
+  EXPECT_EQ(std::numeric_limits<float>::infinity(), laser_scan.ranges.at(8));
+}
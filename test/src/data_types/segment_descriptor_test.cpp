@@ -0,0 +1,123 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "laser_object_tracker/data_types/laser_scan_fragment.hpp"
+#include "laser_object_tracker/data_types/segment_descriptor.hpp"
+
+#include "test/utils.hpp"
+#include "test/data_types/test_data.hpp"
+
+using namespace laser_object_tracker::data_types;
+
+namespace {
+PointCloudType makeCloud(const std::vector<std::pair<float, float>>& points) {
+  PointCloudType cloud;
+  for (const auto& point : points) {
+    cloud.push_back(pcl::PointXYZ(point.first, point.second, 0.0f));
+  }
+
+  return cloud;
+}
+}  // namespace
+
+TEST(SegmentDescriptorTest, EmptyTest) {
+  SegmentDescriptor descriptor;
+  descriptor.points_number = 10;
+  computeSegmentDescriptor(PointCloudType(), descriptor);
+
+  EXPECT_EQ(0, descriptor.points_number);
+  EXPECT_TRUE(descriptor.centroid.isZero());
+  EXPECT_TRUE(descriptor.covariance.isZero());
+  EXPECT_DOUBLE_EQ(0.0, descriptor.obb.area());
+  EXPECT_DOUBLE_EQ(0.0, descriptor.extent);
+}
+
+TEST(SegmentDescriptorTest, RectangleTest) {
+  SegmentDescriptor descriptor;
+  computeSegmentDescriptor(makeCloud({{1.0f, 1.0f}, {3.0f, 1.0f}, {3.0f, 2.0f}, {1.0f, 2.0f}}), descriptor);
+
+  EXPECT_EQ(4, descriptor.points_number);
+  EXPECT_NEAR(2.0, descriptor.centroid(0), test::PRECISION<double>);
+  EXPECT_NEAR(1.5, descriptor.centroid(1), test::PRECISION<double>);
+  EXPECT_NEAR(1.0, descriptor.covariance(0, 0), test::PRECISION<double>);
+  EXPECT_NEAR(0.0, descriptor.covariance(0, 1), test::PRECISION<double>);
+  EXPECT_NEAR(0.0, descriptor.covariance(1, 0), test::PRECISION<double>);
+  EXPECT_NEAR(0.25, descriptor.covariance(1, 1), test::PRECISION<double>);
+  EXPECT_NEAR(1.0, descriptor.min(0), test::PRECISION<double>);
+  EXPECT_NEAR(1.0, descriptor.min(1), test::PRECISION<double>);
+  EXPECT_NEAR(3.0, descriptor.max(0), test::PRECISION<double>);
+  EXPECT_NEAR(2.0, descriptor.max(1), test::PRECISION<double>);
+  EXPECT_NEAR(1.0, descriptor.extent, test::PRECISION<double>);
+  EXPECT_NEAR(2.0, descriptor.obb.area(), test::PRECISION<double>);
+  EXPECT_NEAR(2.0, descriptor.obb.center(0), test::PRECISION<double>);
+  EXPECT_NEAR(1.5, descriptor.obb.center(1), test::PRECISION<double>);
+}
+
+TEST(SegmentDescriptorTest, NonFinitePointsTest) {
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  SegmentDescriptor descriptor;
+  computeSegmentDescriptor(makeCloud({{nan, nan}, {0.0f, 0.0f}, {nan, nan}, {2.0f, 2.0f}, {nan, nan}}), descriptor);
+
+  EXPECT_EQ(2, descriptor.points_number);
+  EXPECT_NEAR(1.0, descriptor.centroid(0), test::PRECISION<double>);
+  EXPECT_NEAR(1.0, descriptor.centroid(1), test::PRECISION<double>);
+  EXPECT_NEAR(1.0, descriptor.covariance(0, 1), test::PRECISION<double>);
+  EXPECT_NEAR(std::sqrt(8.0), descriptor.extent, test::PRECISION<double>);
+  EXPECT_NEAR(0.0, descriptor.obb.area(), test::PRECISION<double>);
+}
+
+TEST(SegmentDescriptorTest, FragmentDescriptorTest) {
+  LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(test::getFragmentUnique2().laser_scan_);
+  LaserScanFragment segment(fragment, 2, 7);
+
+  SegmentDescriptor expected;
+  computeSegmentDescriptor(segment.pointCloud(), expected);
+
+  const auto& descriptor = segment.descriptor();
+  EXPECT_EQ(expected.points_number, descriptor.points_number);
+  EXPECT_TRUE(expected.centroid.isApprox(descriptor.centroid));
+  EXPECT_TRUE(expected.min.isApprox(descriptor.min));
+  EXPECT_TRUE(expected.max.isApprox(descriptor.max));
+  EXPECT_DOUBLE_EQ(expected.obb.area(), descriptor.obb.area());
+
+  LaserScanFragment copy(segment);
+  EXPECT_EQ(&copy.descriptor(), &copy.descriptor());
+  EXPECT_TRUE(expected.centroid.isApprox(copy.descriptor().centroid));
+
+  computeSegmentDescriptor(fragment.pointCloud(), expected);
+  EXPECT_EQ(expected.points_number, fragment.descriptor().points_number);
+  EXPECT_TRUE(expected.centroid.isApprox(fragment.descriptor().centroid));
+}
@@ -0,0 +1,144 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "laser_object_tracker/feature_extraction/incremental_segment_detection.hpp"
+
+#include "test/utils.hpp"
+
+TEST(IncrementalSegmentDetectionTest, AccessorsTest) {
+  using namespace laser_object_tracker::feature_extraction;
+  IncrementalSegmentDetection detection(0.1, 3);
+
+  EXPECT_NEAR(0.1, detection.getDistanceThreshold(), test::PRECISION<double>);
+  EXPECT_EQ(3, detection.getMinPoints());
+
+  detection.setDistanceThreshold(0.2);
+  EXPECT_NEAR(0.2, detection.getDistanceThreshold(), test::PRECISION<double>);
+  detection.setMinPoints(5);
+  EXPECT_EQ(5, detection.getMinPoints());
+
+  EXPECT_THROW(detection.setDistanceThreshold(0.0), std::invalid_argument);
+  EXPECT_THROW(detection.setMinPoints(1), std::invalid_argument);
+}
+
+TEST(IncrementalSegmentDetectionTest, StraightLineTest) {
+  using namespace laser_object_tracker::data_types;
+  using namespace laser_object_tracker::feature_extraction;
+  IncrementalSegmentDetection detection(0.01, 3);
+
+  // Points along x = 1 from (1, -1) to (1, 1)
+  std::vector<float> ranges;
+  for (int i = 0; i < 21; ++i) {
+    ranges.push_back(1.0 / std::cos(-M_PI_4 + i * M_PI_2 / 20));
+  }
+
+  LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(test::generateLaserScan(ranges, -M_PI_4, M_PI_4));
+
+  Eigen::VectorXd feature;
+  ASSERT_TRUE(detection.extractFeature(fragment, feature));
+
+  Eigen::VectorXd expected_feature(4);
+  expected_feature << 1.0, -1.0,
+      1.0, 1.0;
+  EXPECT_TRUE(expected_feature.isApprox(feature, test::PRECISION<double>))
+            << "Expected feature is\n" << expected_feature.transpose()
+            << "\n but actual is\n" << feature.transpose();
+}
+
+TEST(IncrementalSegmentDetectionTest, LShapeTest) {
+  using namespace laser_object_tracker::data_types;
+  using namespace laser_object_tracker::feature_extraction;
+  IncrementalSegmentDetection detection(0.01, 3);
+
+  LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(test::generateLShapeScan(41));
+
+  features::Segments2D segments;
+  ASSERT_TRUE(detection.extractSegments(fragment, segments));
+  ASSERT_EQ(2, segments.size());
+
+  // Corner belongs to the first arm, the second one starts at the next beam
+  double next_beam = M_PI_4 + M_PI / 40;
+  EXPECT_TRUE(Eigen::Vector2d(1.0, -1.0).isApprox(segments.at(0).start_, test::PRECISION<double>));
+  EXPECT_TRUE(Eigen::Vector2d(1.0, 1.0).isApprox(segments.at(0).end_, test::PRECISION<double>));
+  EXPECT_TRUE(Eigen::Vector2d(std::cos(next_beam) / std::sin(next_beam), 1.0).isApprox(segments.at(1).start_,
+                                                                                        test::PRECISION<double>));
+  EXPECT_TRUE(Eigen::Vector2d(-1.0, 1.0).isApprox(segments.at(1).end_, test::PRECISION<double>));
+
+  // Feature holds the same segments
+  Eigen::VectorXd feature;
+  ASSERT_TRUE(detection.extractFeature(fragment, feature));
+  ASSERT_EQ(8, feature.size());
+  EXPECT_TRUE(segments.at(0).start_.isApprox(features::Segment2D(feature.head<4>()).start_));
+  EXPECT_TRUE(segments.at(1).end_.isApprox(features::Segment2D(feature.tail<4>()).end_));
+}
+
+TEST(IncrementalSegmentDetectionTest, MergeNoisyLineTest) {
+  using namespace laser_object_tracker::data_types;
+  using namespace laser_object_tracker::feature_extraction;
+  IncrementalSegmentDetection detection(0.02, 3);
+
+  // Points alternate by 0.015 around x = 1, growing lines are split repeatedly and then merged back
+  std::vector<float> ranges;
+  for (int i = 0; i < 41; ++i) {
+    double angle = -M_PI_4 + i * M_PI_2 / 40;
+    double x = 1.0 + (i % 2 == 0 ? 0.015 : -0.015);
+    ranges.push_back(x / std::cos(angle));
+  }
+
+  LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(test::generateLaserScan(ranges, -M_PI_4, M_PI_4));
+
+  features::Segments2D segments;
+  ASSERT_TRUE(detection.extractSegments(fragment, segments));
+  ASSERT_EQ(1, segments.size());
+  EXPECT_NEAR(1.0, segments.front().start_.x(), 0.001);
+  EXPECT_NEAR(1.0, segments.front().end_.x(), 0.001);
+
+  // Too few points to form a line
+  detection.setMinPoints(50);
+  EXPECT_FALSE(detection.extractSegments(fragment, segments));
+  EXPECT_TRUE(segments.empty());
+}
+
+TEST(IncrementalSegmentDetectionTest, ExceptionThrowTest) {
+  using namespace laser_object_tracker::data_types;
+  using namespace laser_object_tracker::feature_extraction;
+  IncrementalSegmentDetection detection(0.1, 2);
+
+  Eigen::VectorXd feature;
+  EXPECT_THROW(detection.extractFeature(LaserScanFragment(), feature), std::invalid_argument);
+}
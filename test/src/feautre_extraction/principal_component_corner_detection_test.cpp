@@ -0,0 +1,134 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "laser_object_tracker/feature_extraction/principal_component_corner_detection.hpp"
+
+#include "test/utils.hpp"
+
+TEST(PrincipalComponentCornerDetectionTest, AccessorsTest) {
+  using namespace laser_object_tracker::feature_extraction;
+  PrincipalComponentCornerDetection detection(0.3);
+
+  EXPECT_NEAR(0.3, detection.getMinArmAngle(), test::PRECISION<double>);
+
+  detection.setMinArmAngle(0.5);
+  EXPECT_NEAR(0.5, detection.getMinArmAngle(), test::PRECISION<double>);
+
+  EXPECT_THROW(detection.setMinArmAngle(-0.1), std::invalid_argument);
+  EXPECT_THROW(PrincipalComponentCornerDetection(2.0), std::invalid_argument);
+}
+
+TEST(PrincipalComponentCornerDetectionTest, DetectionTest) {
+  using namespace laser_object_tracker::data_types;
+  using namespace laser_object_tracker::feature_extraction;
+  PrincipalComponentCornerDetection detection;
+
+  LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(test::generateLShapeScan(41));
+
+  Eigen::VectorXd feature;
+  ASSERT_TRUE(detection.extractFeature(fragment, feature));
+
+  Eigen::VectorXd expected_feature(6);
+  expected_feature << 1.0, 1.0,
+      1.0, -1.0,
+      -1.0, 1.0;
+  EXPECT_TRUE(expected_feature.isApprox(feature, test::PRECISION<double>))
+            << "Expected feature is\n" << expected_feature.transpose()
+            << "\n but actual is\n" << feature.transpose();
+  EXPECT_NEAR(0.0, detection.getOrientation(), test::PRECISION<double>);
+}
+
+TEST(PrincipalComponentCornerDetectionTest, RotatedDetectionTest) {
+  using namespace laser_object_tracker::data_types;
+  using namespace laser_object_tracker::feature_extraction;
+  PrincipalComponentCornerDetection detection;
+
+  // Same L-shape rotated by 0.3 rad around the sensor
+  auto laser_scan = test::generateLShapeScan(41);
+  laser_scan.angle_min += 0.3;
+  laser_scan.angle_max += 0.3;
+
+  LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(laser_scan);
+
+  Eigen::VectorXd feature;
+  ASSERT_TRUE(detection.extractFeature(fragment, feature));
+
+  Eigen::Rotation2Dd rotation(0.3);
+  Eigen::VectorXd expected_feature(6);
+  expected_feature << rotation * Eigen::Vector2d(1.0, 1.0),
+      rotation * Eigen::Vector2d(1.0, -1.0),
+      rotation * Eigen::Vector2d(-1.0, 1.0);
+  EXPECT_TRUE(expected_feature.isApprox(feature, test::PRECISION<double>))
+            << "Expected feature is\n" << expected_feature.transpose()
+            << "\n but actual is\n" << feature.transpose();
+  EXPECT_NEAR(0.3, detection.getOrientation(), test::PRECISION<double>);
+}
+
+TEST(PrincipalComponentCornerDetectionTest, StraightSegmentTest) {
+  using namespace laser_object_tracker::data_types;
+  using namespace laser_object_tracker::feature_extraction;
+  PrincipalComponentCornerDetection detection;
+
+  // Points along x = 1 from (1, -1) to (1, 1)
+  std::vector<float> ranges;
+  for (int i = 0; i < 21; ++i) {
+    ranges.push_back(1.0 / std::cos(-M_PI_4 + i * M_PI_2 / 20));
+  }
+
+  LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(test::generateLaserScan(ranges, -M_PI_4, M_PI_4));
+
+  Eigen::VectorXd feature;
+  ASSERT_TRUE(detection.extractFeature(fragment, feature));
+
+  Eigen::VectorXd expected_feature(6);
+  expected_feature << 1.0, -1.0,
+      1.0, 1.0,
+      1.0, -1.0;
+  EXPECT_TRUE(expected_feature.isApprox(feature, test::PRECISION<double>))
+            << "Expected feature is\n" << expected_feature.transpose()
+            << "\n but actual is\n" << feature.transpose();
+}
+
+TEST(PrincipalComponentCornerDetectionTest, ExceptionThrowTest) {
+  using namespace laser_object_tracker::data_types;
+  using namespace laser_object_tracker::feature_extraction;
+  PrincipalComponentCornerDetection detection;
+
+  Eigen::VectorXd feature;
+  EXPECT_THROW(detection.extractFeature(LaserScanFragment(), feature), std::invalid_argument);
+}
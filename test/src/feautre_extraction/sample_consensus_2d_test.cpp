@@ -0,0 +1,188 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "laser_object_tracker/feature_extraction/sample_consensus_2d.hpp"
+
+#include "test/utils.hpp"
+
+namespace {
+// Points on y = 0.5 * x + 1 with every fifth point moved far away from the line
+Eigen::Matrix2Xf generateLine(int points_number) {
+  Eigen::Matrix2Xf points(2, points_number);
+  for (int i = 0; i < points_number; ++i) {
+    float x = 0.01f * i;
+    points.col(i) << x, 0.5f * x + 1.0f + (i % 5 == 0 ? 3.0f + 0.001f * i : 0.0f);
+  }
+  return points;
+}
+
+// Corner at (1, 2) with arms along (1, 1) and (1, -1), sampled with the same step on both arms
+Eigen::Matrix2Xf generateCorner(int arm_points_number) {
+  Eigen::Matrix2Xf points(2, 2 * arm_points_number + 1);
+  points.col(0) << 1.0f, 2.0f;
+  for (int i = 1; i <= arm_points_number; ++i) {
+    points.col(2 * i - 1) << 1.0f + 0.125f * i, 2.0f + 0.125f * i;
+    points.col(2 * i) << 1.0f + 0.125f * i, 2.0f - 0.125f * i;
+  }
+  return points;
+}
+}  // namespace
+
+TEST(SampleConsensus2DTest, AccessorsTest) {
+  using namespace laser_object_tracker::feature_extraction;
+  SampleConsensus2D<LineModel2D> sample_consensus(0.1, 100, 0.99);
+
+  EXPECT_NEAR(0.1, sample_consensus.getDistanceThreshold(), test::PRECISION<double>);
+  EXPECT_EQ(100, sample_consensus.getMaxIterations());
+  EXPECT_NEAR(0.99, sample_consensus.getProbability(), test::PRECISION<double>);
+  EXPECT_LE(1, sample_consensus.getThreadsNumber());
+
+  sample_consensus.setBatchSize(8);
+  EXPECT_EQ(8, sample_consensus.getBatchSize());
+  sample_consensus.setThreadsNumber(3);
+  EXPECT_EQ(3, sample_consensus.getThreadsNumber());
+  sample_consensus.setParallelThreshold(10);
+  EXPECT_EQ(10, sample_consensus.getParallelThreshold());
+
+  EXPECT_THROW(sample_consensus.setBatchSize(0), std::invalid_argument);
+  EXPECT_THROW(sample_consensus.setThreadsNumber(0), std::invalid_argument);
+}
+
+TEST(SampleConsensus2DTest, NotEnoughPointsTest) {
+  using namespace laser_object_tracker::feature_extraction;
+  SampleConsensus2D<CrossModel2D> sample_consensus(0.1, 100, 0.99);
+
+  Eigen::Matrix2Xf points(2, 2);
+  points << 0.0f, 1.0f,
+            0.0f, 1.0f;
+  EXPECT_FALSE(sample_consensus.computeModel(points));
+  EXPECT_TRUE(sample_consensus.getInliers().empty());
+}
+
+TEST(SampleConsensus2DTest, DegenerateTest) {
+  using namespace laser_object_tracker::feature_extraction;
+  SampleConsensus2D<LineModel2D> sample_consensus(0.1, 100, 0.99);
+
+  // Coinciding points give no valid hypothesis, so none is counted as an iteration
+  Eigen::Matrix2Xf points = Eigen::Matrix2Xf::Ones(2, 10);
+  EXPECT_FALSE(sample_consensus.computeModel(points));
+  EXPECT_EQ(0, sample_consensus.getIterations());
+  EXPECT_TRUE(sample_consensus.getInliers().empty());
+}
+
+TEST(SampleConsensus2DTest, LineTest) {
+  using namespace laser_object_tracker::feature_extraction;
+  SampleConsensus2D<LineModel2D> sample_consensus(0.01, 1000, 0.99);
+
+  Eigen::Matrix2Xf points = generateLine(500);
+  ASSERT_TRUE(sample_consensus.computeModel(points));
+
+  EXPECT_EQ(400, sample_consensus.getInliers().size());
+  for (int index : sample_consensus.getInliers()) {
+    EXPECT_NE(0, index % 5);
+  }
+
+  const auto& coefficients = sample_consensus.getModelCoefficients();
+  Eigen::Vector2f expected_direction = Eigen::Vector2f(1.0f, 0.5f).normalized();
+  EXPECT_NEAR(1.0f, std::fabs(expected_direction.dot(coefficients.tail<2>())), 1e-4);
+  EXPECT_NEAR(0.5f * coefficients(0) + 1.0f, coefficients(1), 1e-4);
+
+  // With 80% inliers adaptive termination needs only a few hypotheses
+  EXPECT_GT(1000, sample_consensus.getIterations());
+}
+
+TEST(SampleConsensus2DTest, CrossTest) {
+  using namespace laser_object_tracker::feature_extraction;
+  SampleConsensus2D<CrossModel2D> sample_consensus(0.01, 1000, 0.99);
+
+  Eigen::Matrix2Xf points = generateCorner(20);
+  ASSERT_TRUE(sample_consensus.computeModel(points));
+
+  EXPECT_EQ(points.cols(), sample_consensus.getInliers().size());
+  const auto& coefficients = sample_consensus.getModelCoefficients();
+  EXPECT_NEAR(1.0f, coefficients(0), 1e-4);
+  EXPECT_NEAR(2.0f, coefficients(1), 1e-4);
+  EXPECT_NEAR(M_SQRT1_2, std::fabs(coefficients(2)), 1e-4);
+  EXPECT_NEAR(M_SQRT1_2, std::fabs(coefficients(3)), 1e-4);
+}
+
+TEST(SampleConsensus2DTest, ThreadsIndependentResultTest) {
+  using namespace laser_object_tracker::feature_extraction;
+  SampleConsensus2D<LineModel2D> sequential(0.01, 200, 0.9999);
+  SampleConsensus2D<LineModel2D> parallel(0.01, 200, 0.9999);
+  sequential.setThreadsNumber(1);
+  parallel.setThreadsNumber(4);
+  parallel.setParallelThreshold(0);
+
+  Eigen::Matrix2Xf points = generateLine(3000);
+  ASSERT_TRUE(sequential.computeModel(points));
+  ASSERT_TRUE(parallel.computeModel(points));
+
+  EXPECT_EQ(sequential.getIterations(), parallel.getIterations());
+  EXPECT_EQ(sequential.getModelCoefficients(), parallel.getModelCoefficients());
+  EXPECT_EQ(sequential.getInliers(), parallel.getInliers());
+}
+
+TEST(SampleConsensus2DTest, StridedViewTest) {
+  using namespace laser_object_tracker::feature_extraction;
+  SampleConsensus2D<LineModel2D> contiguous(0.01, 200, 0.99);
+  SampleConsensus2D<LineModel2D> strided(0.01, 200, 0.99);
+
+  // Same layout as a point cloud, coordinates are followed by two unused values
+  Eigen::Matrix2Xf points = generateLine(300);
+  Eigen::Matrix4Xf cloud = Eigen::Matrix4Xf::Constant(4, points.cols(), 100.0f);
+  cloud.topRows<2>() = points;
+  Eigen::Map<const Eigen::Matrix2Xf, Eigen::Unaligned, Eigen::OuterStride<>> view(cloud.data(),
+                                                                                 2,
+                                                                                 cloud.cols(),
+                                                                                 Eigen::OuterStride<>(4));
+
+  ASSERT_TRUE(contiguous.computeModel(points));
+  ASSERT_TRUE(strided.computeModel(view));
+  EXPECT_EQ(contiguous.getModelCoefficients(), strided.getModelCoefficients());
+  EXPECT_EQ(contiguous.getInliers(), strided.getInliers());
+}
+
+TEST(SampleConsensus2DTest, RepeatedCallsTest) {
+  using namespace laser_object_tracker::feature_extraction;
+  SampleConsensus2D<LineModel2D> sample_consensus(0.01, 1000, 0.99);
+
+  // Buffers are reused between inputs of different sizes
+  for (int points_number : {500, 50, 1000, 5}) {
+    Eigen::Matrix2Xf points = generateLine(points_number);
+    ASSERT_TRUE(sample_consensus.computeModel(points));
+    EXPECT_EQ(points_number - (points_number + 4) / 5, sample_consensus.getInliers().size());
+  }
+}
@@ -31,6 +31,8 @@
 *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *********************************************************************/
 
+#include <random>
+
 #include <gtest/gtest.h>
 
 #include "laser_object_tracker/feature_extraction/pcl/sac_model_cross2d.hpp"
@@ -165,6 +167,34 @@ TEST(SampleConsensusModelCross2DTest, OptimizeModelCoefficientsTest) {
             << "\nbut actual are\n" << optimized_coefficients.transpose();
 }
 
+TEST(SampleConsensusModelCross2DTest, OptimizeModelCoefficientsInliersTest) {
+  // Corner at (1, 2) with arms along (1, 1) and (1, -1), preceded by outliers, which are not passed as inliers
+  PointCloud cloud;
+  std::vector<int> inliers;
+  for (int i = 0; i < 10; ++i) {
+    cloud.push_back({10.0f + i, -20.0f, 0.0f});
+  }
+  for (int i = 0; i < 50; ++i) {
+    inliers.push_back(cloud.size());
+    cloud.push_back({1.0f + 0.05f * i, 2.0f + 0.05f * i, 0.0f});
+    inliers.push_back(cloud.size());
+    cloud.push_back({1.0f + 0.05f * (i + 1), 2.0f - 0.05f * (i + 1), 0.0f});
+  }
+  Model model(cloud.makeShared());
+
+  Eigen::VectorXf model_coefficients(4);
+  model_coefficients << 1.05, 1.95, 0.6, 0.8;
+  Eigen::VectorXf optimized_coefficients;
+  model.optimizeModelCoefficients(inliers, model_coefficients, optimized_coefficients);
+
+  ASSERT_EQ(4, optimized_coefficients.size());
+  EXPECT_NEAR(1.0, optimized_coefficients(0), 1e-3);
+  EXPECT_NEAR(2.0, optimized_coefficients(1), 1e-3);
+  Eigen::Vector2f direction = optimized_coefficients.tail<2>().normalized();
+  EXPECT_NEAR(M_SQRT1_2, direction.cwiseAbs()(0), 1e-3);
+  EXPECT_NEAR(M_SQRT1_2, direction.cwiseAbs()(1), 1e-3);
+}
+
 TEST(SampleConsensusModelCross2DTest, GetDistanceToModelTest) {
   PointCloud cloud;
   cloud.points = {
@@ -262,6 +292,70 @@ TEST(SampleConsensusModelCross2DTest, CountWithinDistanceTest) {
   EXPECT_EQ(1, model.countWithinDistance(model_coefficients, 0.3));
 
   EXPECT_EQ(5, model.countWithinDistance(model_coefficients, 0.5));
+
+  // Same number of indices selecting other points, gathered coordinates are refreshed
+  model_coefficients << 0.0, 0.0, 1.0, 0.0;
+  model.setIndices(std::vector<int>{0, 1, 2, 3, 4, 5, 6});
+  EXPECT_EQ(5, model.countWithinDistance(model_coefficients, 10.0));
+  model.setIndices(std::vector<int>{4, 6, 4, 6, 4, 6, 4});
+  EXPECT_EQ(0, model.countWithinDistance(model_coefficients, 10.0));
+
+  // Other cloud of the same size
+  PointCloud far_cloud;
+  far_cloud.points.assign(7, {40.0, 40.0, 0.0});
+  model.setIndices(std::vector<int>{0, 1, 2, 3, 4, 5, 6});
+  EXPECT_EQ(5, model.countWithinDistance(model_coefficients, 10.0));
+  model.setInputCloud(far_cloud.makeShared());
+  EXPECT_EQ(0, model.countWithinDistance(model_coefficients, 10.0));
+}
+
+TEST(SampleConsensusModelCross2DTest, VectorizedKernelTest) {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<float> distribution(-5.0f, 5.0f);
+
+  // Size not divisible by the vector width, so that both vectorized and scalar parts are used
+  PointCloud cloud;
+  for (int i = 0; i < 1003; ++i) {
+    cloud.push_back({distribution(generator), distribution(generator), 0.0});
+  }
+  Model model(cloud.makeShared());
+
+  Eigen::VectorXf model_coefficients(4);
+  for (int repetition = 0; repetition < 20; ++repetition) {
+    model_coefficients << distribution(generator), distribution(generator),
+        distribution(generator), distribution(generator);
+    double threshold = 0.1 + 0.05 * repetition;
+
+    // Reference is the original point by point implementation
+    Eigen::Vector4f corner_point(model_coefficients[0], model_coefficients[1], 0.0, 0.0);
+    Eigen::Vector4f line_1_direction(model_coefficients[2], model_coefficients[3], 0.0, 0.0);
+    Eigen::Vector4f line_2_direction(model_coefficients[3], -model_coefficients[2], 0.0, 0.0);
+    line_1_direction.normalize();
+    line_2_direction.normalize();
+    std::vector<int> expected_inliers;
+    std::vector<double> expected_distances;
+    for (int i = 0; i < cloud.size(); ++i) {
+      Eigen::Vector4f point(cloud.at(i).x, cloud.at(i).y, 0.0, 0.0);
+      double squared_distance = std::min(pcl::sqrPointToLineDistance(point, corner_point, line_1_direction),
+                                         pcl::sqrPointToLineDistance(point, corner_point, line_2_direction));
+      expected_distances.push_back(std::sqrt(squared_distance));
+      if (squared_distance < threshold * threshold) {
+        expected_inliers.push_back(i);
+      }
+    }
+
+    std::vector<int> inliers;
+    model.selectWithinDistance(model_coefficients, threshold, inliers);
+    EXPECT_EQ(expected_inliers, inliers);
+    EXPECT_EQ(expected_inliers.size(), model.countWithinDistance(model_coefficients, threshold));
+
+    std::vector<double> distances;
+    model.getDistancesToModel(model_coefficients, distances);
+    ASSERT_EQ(expected_distances.size(), distances.size());
+    for (int i = 0; i < expected_distances.size(); ++i) {
+      EXPECT_NEAR(expected_distances.at(i), distances.at(i), test::PRECISION<double>);
+    }
+  }
 }
 
 TEST(SampleConsensusModelCross2DTest, ProjectPointsTest) {
@@ -148,6 +148,61 @@ TEST(SearchBasedCornerDetectionTest, DetectionClosenesssCriterionTest) {
             << "\n but actual is\n" << feature.transpose();
 }
 
+TEST(SearchBasedCornerDetectionTest, OrientationHintTest) {
+  using namespace laser_object_tracker::data_types;
+  using namespace laser_object_tracker::feature_extraction;
+  int assessments = 0;
+  SearchBasedCornerDetection detection(0.001, [&assessments](const Eigen::VectorXd& x, const Eigen::VectorXd& y) {
+    ++assessments;
+    return closenessCriterion(x, y);
+  });
+  EXPECT_NEAR(0.07, detection.getHintWindow(), test::PRECISION<double>);
+  detection.setHintWindow(0.05);
+  EXPECT_NEAR(0.05, detection.getHintWindow(), test::PRECISION<double>);
+
+  // L-shape rotated by 0.3 rad, with arms of length 2 meeting at the corner
+  LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(test::generateLShapeScan(41, 0.3));
+
+  Eigen::VectorXd full_feature;
+  ASSERT_TRUE(detection.extractFeature(fragment, full_feature));
+  int full_assessments = assessments;
+  double full_orientation = detection.getOrientation();
+  EXPECT_NEAR(0.3, full_orientation, 0.01);
+
+  // Hint close to the actual orientation narrows the search
+  Eigen::VectorXd hinted_feature;
+  assessments = 0;
+  ASSERT_TRUE(detection.extractFeature(fragment, hinted_feature, 0.31));
+  EXPECT_GT(full_assessments / 10, assessments);
+  EXPECT_TRUE(full_feature.isApprox(hinted_feature, test::PRECISION<double>))
+            << "Expected feature is\n" << full_feature.transpose()
+            << "\n but actual is\n" << hinted_feature.transpose();
+  EXPECT_NEAR(full_orientation, detection.getOrientation(), test::PRECISION<double>);
+
+  // Optimum outside of the window triggers the full sweep
+  assessments = 0;
+  ASSERT_TRUE(detection.extractFeature(fragment, hinted_feature, 1.0));
+  EXPECT_LT(full_assessments, assessments);
+  EXPECT_TRUE(full_feature.isApprox(hinted_feature, test::PRECISION<double>))
+            << "Expected feature is\n" << full_feature.transpose()
+            << "\n but actual is\n" << hinted_feature.transpose();
+
+  // Assessment below the threshold triggers the full sweep, even with the optimum inside of the window
+  double best_assessment = detection.getAssessment();
+  detection.setMinHintAssessment(best_assessment - 1.0);
+  EXPECT_NEAR(best_assessment - 1.0, detection.getMinHintAssessment(), test::PRECISION<double>);
+  assessments = 0;
+  ASSERT_TRUE(detection.extractFeature(fragment, hinted_feature, 0.31));
+  EXPECT_GT(full_assessments / 10, assessments);
+
+  detection.setMinHintAssessment(best_assessment + 1.0);
+  assessments = 0;
+  ASSERT_TRUE(detection.extractFeature(fragment, hinted_feature, 0.31));
+  EXPECT_LT(full_assessments, assessments);
+  EXPECT_TRUE(full_feature.isApprox(hinted_feature, test::PRECISION<double>));
+}
+
 TEST(SearchBasedCornerDetectionTest, ExceptionThrowTest) {
   using namespace laser_object_tracker::data_types;
   using namespace laser_object_tracker::feature_extraction;
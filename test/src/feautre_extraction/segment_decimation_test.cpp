@@ -0,0 +1,108 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "laser_object_tracker/feature_extraction/search_based_corner_detection.hpp"
+#include "laser_object_tracker/feature_extraction/segment_decimation.hpp"
+
+#include "test/utils.hpp"
+
+TEST(SegmentDecimationTest, AccessorsTest) {
+  using namespace laser_object_tracker::feature_extraction;
+  SegmentDecimation decimation(0.05, 0.01);
+
+  EXPECT_NEAR(0.05, decimation.getMinSpacing(), test::PRECISION<double>);
+  EXPECT_NEAR(0.01, decimation.getAngularSpacing(), test::PRECISION<double>);
+  EXPECT_NEAR(0.05, decimation.getTargetSpacing(1.0), test::PRECISION<double>);
+  EXPECT_NEAR(0.1, decimation.getTargetSpacing(10.0), test::PRECISION<double>);
+
+  decimation.setMinSpacing(0.1);
+  EXPECT_NEAR(0.1, decimation.getMinSpacing(), test::PRECISION<double>);
+  decimation.setAngularSpacing(0.02);
+  EXPECT_NEAR(0.02, decimation.getAngularSpacing(), test::PRECISION<double>);
+
+  EXPECT_THROW(decimation.setMinSpacing(-0.1), std::invalid_argument);
+  EXPECT_THROW(decimation.setAngularSpacing(-0.1), std::invalid_argument);
+}
+
+TEST(SegmentDecimationTest, DecimationTest) {
+  using namespace laser_object_tracker::data_types;
+  using namespace laser_object_tracker::feature_extraction;
+  SegmentDecimation decimation(0.1, 0.0);
+
+  LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(test::generateLShapeScan(801));
+
+  Eigen::Matrix2Xf points;
+  long size = decimation.decimate(fragment, points);
+
+  // Arms of total length 4 at spacing 0.1, plus a few extremes
+  EXPECT_LE(40, size);
+  EXPECT_GE(50, size);
+  EXPECT_LE(801, points.cols());
+
+  // Ends and the corner are kept
+  EXPECT_TRUE(Eigen::Vector2f(1.0f, -1.0f).isApprox(points.col(0), 1e-4f));
+  EXPECT_TRUE(Eigen::Vector2f(-1.0f, 1.0f).isApprox(points.col(size - 1), 1e-4f));
+  bool corner_kept = false;
+  for (long i = 0; i < size; ++i) {
+    corner_kept |= (points.col(i) - Eigen::Vector2f(1.0f, 1.0f)).norm() < 1e-4f;
+  }
+  EXPECT_TRUE(corner_kept);
+
+  // Spacing larger than the segment keeps ends and extremes only
+  decimation.setMinSpacing(10.0);
+  EXPECT_GE(5, decimation.decimate(fragment, points));
+
+  EXPECT_EQ(0, decimation.decimate(LaserScanFragment(), points));
+}
+
+TEST(SegmentDecimationTest, FeatureExtractionTest) {
+  using namespace laser_object_tracker::data_types;
+  using namespace laser_object_tracker::feature_extraction;
+  SearchBasedCornerDetection detection(0.01, areaCriterion);
+
+  LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(test::generateLShapeScan(801));
+
+  Eigen::VectorXd feature, decimated_feature;
+  ASSERT_TRUE(detection.extractFeature(fragment, feature));
+
+  detection.setDecimation(std::make_shared<SegmentDecimation>(0.1, 0.0));
+  ASSERT_NE(nullptr, detection.getDecimation());
+  ASSERT_TRUE(detection.extractFeature(fragment, decimated_feature));
+  EXPECT_TRUE(feature.isApprox(decimated_feature, test::PRECISION<double>))
+            << "Expected feature is\n" << feature.transpose()
+            << "\n but actual is\n" << decimated_feature.transpose();
+}
@@ -77,4 +77,100 @@ TEST(AggregatedSegmentedFilteringTest, ShouldFilterTest) {
 //  filter.add(std::move(mock_filter_3));
 //  EXPECT_TRUE(filter.shouldFilter(fragment));
 //  EXPECT_FALSE(filter.shouldFilter(fragment));
-}
\ No newline at end of file
+}
+
+TEST(AggregatedSegmentedFilteringTest, ReorderTest) {
+  std::unique_ptr<test::FilterMock> mock_filter_1(new test::FilterMock()),
+                                    mock_filter_2(new test::FilterMock());
+
+  // Second filter rejects everything, so it should be moved in front of the first one on reordering
+  EXPECT_CALL(*mock_filter_1, shouldFilter(testing::_))
+      .Times(2)
+      .WillRepeatedly(testing::Return(false));
+  EXPECT_CALL(*mock_filter_2, shouldFilter(testing::_))
+      .Times(5)
+      .WillRepeatedly(testing::Return(true));
+
+  std::vector<std::unique_ptr<laser_object_tracker::filtering::BaseSegmentedFiltering>> filters;
+  filters.push_back(std::move(mock_filter_1));
+  filters.push_back(std::move(mock_filter_2));
+
+  laser_object_tracker::filtering::AggregateSegmentedFiltering filter(std::move(filters), 3);
+  EXPECT_EQ(std::vector<size_t>({0, 1}), filter.getEvaluationOrder());
+
+  laser_object_tracker::data_types::LaserScanFragment fragment;
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(filter.shouldFilter(fragment));
+  }
+  EXPECT_EQ(std::vector<size_t>({1, 0}), filter.getEvaluationOrder());
+
+  // Statistics are halved on reordering, before the third call
+  const auto& statistics = filter.getStatistics();
+  ASSERT_EQ(2, statistics.size());
+  EXPECT_DOUBLE_EQ(1.0, statistics.at(0).calls);
+  EXPECT_DOUBLE_EQ(0.0, statistics.at(0).rejections);
+  EXPECT_DOUBLE_EQ(0.0, statistics.at(0).rejectionRate());
+  EXPECT_DOUBLE_EQ(4.0, statistics.at(1).calls);
+  EXPECT_DOUBLE_EQ(4.0, statistics.at(1).rejections);
+  EXPECT_DOUBLE_EQ(1.0, statistics.at(1).rejectionRate());
+}
+
+TEST(AggregatedSegmentedFilteringTest, SampledTimingTest) {
+  std::unique_ptr<test::FilterMock> mock_filter(new test::FilterMock());
+  EXPECT_CALL(*mock_filter, shouldFilter(testing::_))
+      .Times(10)
+      .WillRepeatedly(testing::Return(false));
+
+  std::vector<std::unique_ptr<laser_object_tracker::filtering::BaseSegmentedFiltering>> filters;
+  filters.push_back(std::move(mock_filter));
+
+  laser_object_tracker::filtering::AggregateSegmentedFiltering filter(std::move(filters), 0);
+  EXPECT_EQ(16, filter.getTimingPeriod());
+  EXPECT_DOUBLE_EQ(0.5, filter.getStatisticsDecay());
+  EXPECT_THROW(filter.setTimingPeriod(0), std::invalid_argument);
+  EXPECT_THROW(filter.setStatisticsDecay(0.0), std::invalid_argument);
+  EXPECT_THROW(filter.setStatisticsDecay(1.5), std::invalid_argument);
+
+  filter.setTimingPeriod(4);
+  laser_object_tracker::data_types::LaserScanFragment fragment;
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_FALSE(filter.shouldFilter(fragment));
+  }
+
+  // Calls 1, 5 and 9 are timed
+  EXPECT_DOUBLE_EQ(10.0, filter.getStatistics().front().calls);
+  EXPECT_DOUBLE_EQ(3.0, filter.getStatistics().front().timed_calls);
+  EXPECT_GE(filter.getStatistics().front().averageCost(), 0.0);
+}
+
+TEST(AggregatedSegmentedFilteringTest, FixedOrderTest) {
+  std::unique_ptr<test::FilterMock> mock_filter_1(new test::FilterMock()),
+                                    mock_filter_2(new test::FilterMock());
+
+  EXPECT_CALL(*mock_filter_1, shouldFilter(testing::_))
+      .WillOnce(testing::Return(true))
+      .WillOnce(testing::Return(false))
+      .WillOnce(testing::Return(false));
+  EXPECT_CALL(*mock_filter_2, shouldFilter(testing::_))
+      .WillOnce(testing::Return(true))
+      .WillOnce(testing::Return(false));
+
+  std::vector<std::unique_ptr<laser_object_tracker::filtering::BaseSegmentedFiltering>> filters;
+  filters.push_back(std::move(mock_filter_1));
+
+  laser_object_tracker::filtering::AggregateSegmentedFiltering filter(std::move(filters), 0);
+  filter.add(std::move(mock_filter_2));
+
+  laser_object_tracker::data_types::LaserScanFragment fragment;
+  EXPECT_TRUE(filter.shouldFilter(fragment));
+  EXPECT_TRUE(filter.shouldFilter(fragment));
+  EXPECT_FALSE(filter.shouldFilter(fragment));
+  EXPECT_EQ(std::vector<size_t>({0, 1}), filter.getEvaluationOrder());
+
+  EXPECT_DOUBLE_EQ(3.0, filter.getStatistics().at(0).calls);
+  EXPECT_DOUBLE_EQ(2.0, filter.getStatistics().at(1).calls);
+
+  filter.resetStatistics();
+  EXPECT_DOUBLE_EQ(0.0, filter.getStatistics().at(0).calls);
+  EXPECT_DOUBLE_EQ(0.0, filter.getStatistics().at(1).calls);
+}
@@ -0,0 +1,139 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "laser_object_tracker/filtering/occlusion_detection.hpp"
+#include "laser_object_tracker/filtering/segment_merging.hpp"
+#include "laser_object_tracker/segmentation/breakpoint_detection.hpp"
+
+#include "test/utils.hpp"
+
+namespace {
+std::vector<laser_object_tracker::data_types::LaserScanFragment> segment(const std::vector<float>& ranges) {
+  laser_object_tracker::data_types::LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(test::generateLaserScan(ranges, -0.1, 0.1));
+
+  std::vector<laser_object_tracker::data_types::LaserScanFragment> segments;
+  laser_object_tracker::segmentation::BreakpointDetection(0.2).segment(fragment, segments);
+  laser_object_tracker::filtering::OcclusionDetection(0.05).filter(segments);
+
+  return segments;
+}
+}  // namespace
+
+TEST(SegmentMergingTest, ConstructorAndAccessorsTest) {
+  laser_object_tracker::filtering::SegmentMerging merging(0.3);
+  EXPECT_DOUBLE_EQ(0.3, merging.getMaxGapDistance());
+  EXPECT_EQ(1, merging.getMaxSkippedSegments());
+
+  merging.setMaxGapDistance(0.5);
+  EXPECT_DOUBLE_EQ(0.5, merging.getMaxGapDistance());
+  merging.setMaxSkippedSegments(0);
+  EXPECT_EQ(0, merging.getMaxSkippedSegments());
+
+  EXPECT_THROW(merging.setMaxGapDistance(-0.1), std::invalid_argument);
+  EXPECT_THROW(merging.setMaxSkippedSegments(-1), std::invalid_argument);
+
+  laser_object_tracker::data_types::LaserScanFragment fragment;
+  EXPECT_FALSE(merging.shouldFilter(fragment));
+}
+
+TEST(SegmentMergingTest, NeighboursTest) {
+  // Two legs split by the breakpoint, end points 0.25 apart
+  auto segments = segment({2.0, 2.0, 2.0, 2.0, 2.25, 2.25, 2.25, 2.25});
+  ASSERT_EQ(2, segments.size());
+
+  laser_object_tracker::filtering::SegmentMerging merging(0.1);
+  merging.filter(segments);
+  EXPECT_EQ(2, segments.size());
+
+  merging.setMaxGapDistance(0.3);
+  merging.filter(segments);
+  ASSERT_EQ(1, segments.size());
+  ASSERT_EQ(8, segments.front().size());
+  EXPECT_NEAR(2.0, segments.front().front().range(), test::PRECISION<double>);
+  EXPECT_NEAR(2.25, segments.front().back().range(), test::PRECISION<double>);
+  EXPECT_EQ(8, segments.front().descriptor().points_number);
+
+  std::vector<laser_object_tracker::data_types::LaserScanFragment> empty;
+  merging.filter(empty);
+  EXPECT_TRUE(empty.empty());
+}
+
+TEST(SegmentMergingTest, OcclusionTest) {
+  laser_object_tracker::filtering::SegmentMerging merging(0.3);
+
+  // Object partially occluded by a closer one, gap between visible parts is about 0.2
+  std::vector<float> ranges{3.0, 3.0, 3.0, 3.0, 3.0, 1.0, 1.0, 1.0, 3.0, 3.0, 3.0, 3.0, 3.0};
+  auto segments = segment(ranges);
+  ASSERT_EQ(3, segments.size());
+  auto occluder = segments.at(1);
+  auto occluded = segments.back();
+  merging.filter(segments);
+  ASSERT_EQ(2, segments.size());
+  ASSERT_EQ(10, segments.front().size());
+  EXPECT_EQ(10, segments.front().laserScan().ranges.size());
+  EXPECT_EQ(10, segments.front().descriptor().points_number);
+  EXPECT_EQ(occluder, segments.back());
+  for (const auto& element : segments.front()) {
+    EXPECT_NEAR(3.0, element.range(), test::PRECISION<double>);
+  }
+
+  // Elements behind the occluder keep their bearings
+  EXPECT_FALSE(segments.front().hasEvenlySpacedAngles());
+  for (int i = 0; i < occluded.size(); ++i) {
+    EXPECT_DOUBLE_EQ(occluded[i].getAngle(), segments.front()[5 + i].getAngle());
+  }
+
+  // Segments in between are not skipped, if disabled
+  segments = segment(ranges);
+  merging.setMaxSkippedSegments(0);
+  merging.filter(segments);
+  EXPECT_EQ(3, segments.size());
+  merging.setMaxSkippedSegments(1);
+
+  // Segment in between is behind, so it does not occlude the gap
+  std::fill(ranges.begin() + 5, ranges.begin() + 8, 5.0f);
+  segments = segment(ranges);
+  merging.filter(segments);
+  EXPECT_EQ(3, segments.size());
+
+  // Ends of the segment in between are not flagged without OcclusionDetection
+  std::fill(ranges.begin() + 5, ranges.begin() + 8, 1.0f);
+  laser_object_tracker::data_types::LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(test::generateLaserScan(ranges, -0.1, 0.1));
+  laser_object_tracker::segmentation::BreakpointDetection(0.2).segment(fragment, segments);
+  merging.filter(segments);
+  EXPECT_EQ(3, segments.size());
+}
@@ -0,0 +1,89 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "laser_object_tracker/filtering/aggregate_segmented_filtering.hpp"
+#include "laser_object_tracker/filtering/obb_area_filter.hpp"
+#include "laser_object_tracker/filtering/points_number_filter.hpp"
+#include "laser_object_tracker/filtering/static_filter_cascade.hpp"
+
+#include "test/utils.hpp"
+
+using laser_object_tracker::filtering::OBBAreaFilter;
+using laser_object_tracker::filtering::PointsNumberFilter;
+
+TEST(StaticFilterCascadeTest, AccessorsTest) {
+  laser_object_tracker::filtering::StaticFilterCascade<PointsNumberFilter, OBBAreaFilter> filter(
+      PointsNumberFilter(2, 5), OBBAreaFilter(0.0, 1.0, 0.1));
+  EXPECT_EQ(2, filter.get<0>().getMinPoints());
+  EXPECT_DOUBLE_EQ(1.0, filter.get<1>().getMaxArea());
+
+  filter.get<0>().setMinPoints(3);
+  EXPECT_EQ(3, filter.get<0>().getMinPoints());
+}
+
+TEST(StaticFilterCascadeTest, EquivalenceWithAggregateTest) {
+  PointsNumberFilter points_filter(2, 5);
+  OBBAreaFilter obb_filter(0.0, 0.5, 0.1);
+
+  laser_object_tracker::filtering::StaticFilterCascade<PointsNumberFilter, OBBAreaFilter> cascade(points_filter,
+                                                                                                  obb_filter);
+  std::vector<std::unique_ptr<laser_object_tracker::filtering::BaseSegmentedFiltering>> filters;
+  filters.push_back(std::make_unique<PointsNumberFilter>(points_filter));
+  filters.push_back(std::make_unique<OBBAreaFilter>(obb_filter));
+  laser_object_tracker::filtering::AggregateSegmentedFiltering aggregate(std::move(filters));
+
+  laser_object_tracker::data_types::LaserScanFragment::LaserScanFragmentFactory factory;
+  auto scan = factory.fromLaserScan(test::generateLaserScan({1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0}, 0.0, 1.5));
+
+  std::vector<laser_object_tracker::data_types::LaserScanFragment> fragments;
+  for (long first = 0; first < scan.size(); ++first) {
+    for (long last = first + 1; last <= scan.size(); ++last) {
+      fragments.emplace_back(scan, first, last);
+      EXPECT_EQ(aggregate.shouldFilter(fragments.back()), cascade.shouldFilter(fragments.back()));
+    }
+  }
+
+  auto aggregate_fragments = fragments;
+  const auto fragments_number = fragments.size();
+  aggregate.filter(aggregate_fragments);
+  cascade.filter(fragments);
+
+  ASSERT_EQ(aggregate_fragments.size(), fragments.size());
+  EXPECT_LT(0, fragments.size());
+  EXPECT_GT(fragments_number, fragments.size());
+  for (int i = 0; i < fragments.size(); ++i) {
+    EXPECT_EQ(aggregate_fragments.at(i), fragments.at(i));
+  }
+}
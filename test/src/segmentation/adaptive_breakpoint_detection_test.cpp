@@ -65,6 +65,14 @@ TEST_P(AdaptiveBreakpointDetectionTestWithParam, SegmentationTest) {
 
   auto value = segmentation_ptr_->segment(reference.fragment_);
   EXPECT_EQ(reference.segmented_fragment_, value);
+
+  // Buffer holding segments of a previous frame is cleared and keeps its capacity
+  std::vector<laser_object_tracker::data_types::LaserScanFragment> segments(value);
+  segments.resize(segments.size() + 3);
+  auto capacity = segments.capacity();
+  segmentation_ptr_->segment(reference.fragment_, segments);
+  EXPECT_EQ(reference.segmented_fragment_, segments);
+  EXPECT_EQ(capacity, segments.capacity());
 }
 
 INSTANTIATE_TEST_CASE_P(AdaptiveBreakpointDetectionTestData,
@@ -0,0 +1,199 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "laser_object_tracker/segmentation/background_subtraction.hpp"
+#include "laser_object_tracker/segmentation/breakpoint_detection.hpp"
+
+#include "test/utils.hpp"
+
+TEST(BackgroundSubtractionTest, AccessorsTest) {
+  laser_object_tracker::segmentation::BackgroundSubtraction background(8, 6, 0.1, 2);
+  EXPECT_EQ(8, background.getHistorySize());
+  EXPECT_EQ(6, background.getMinMatches());
+  EXPECT_NEAR(0.1, background.getDistanceTolerance(), test::PRECISION<double>);
+  EXPECT_EQ(2, background.getUpdatePeriod());
+
+  background.setMinMatches(3);
+  EXPECT_EQ(3, background.getMinMatches());
+  background.setDistanceTolerance(0.2);
+  EXPECT_NEAR(0.2, background.getDistanceTolerance(), test::PRECISION<double>);
+
+  EXPECT_THROW(background.setMinMatches(9), std::invalid_argument);
+  EXPECT_THROW(background.setMinMatches(0), std::invalid_argument);
+  EXPECT_THROW(background.setDistanceTolerance(-0.1), std::invalid_argument);
+  EXPECT_THROW(laser_object_tracker::segmentation::BackgroundSubtraction(0, 1, 0.1, 1), std::invalid_argument);
+  EXPECT_THROW(laser_object_tracker::segmentation::BackgroundSubtraction(4, 1, 0.1, 0), std::invalid_argument);
+}
+
+TEST(BackgroundSubtractionTest, StaticSceneTest) {
+  laser_object_tracker::segmentation::BackgroundSubtraction background(4, 3, 0.1, 1);
+  auto wall = test::generateLaserScan(std::vector<float>(10, 5.0f));
+
+  // Model converges after min matches scans
+  for (int i = 0; i < 3; ++i) {
+    auto laser_scan = wall;
+    EXPECT_EQ(10, background.apply(laser_scan));
+    EXPECT_TRUE(test::compare(wall, laser_scan));
+  }
+
+  auto laser_scan = wall;
+  laser_scan.ranges.at(3) = 5.05f;
+  EXPECT_EQ(0, background.apply(laser_scan));
+  for (float range : laser_scan.ranges) {
+    EXPECT_TRUE(std::isinf(range));
+  }
+
+  // Object in front of the wall is kept, together with indices of its beams
+  laser_scan = wall;
+  laser_scan.ranges.at(4) = 2.0f;
+  laser_scan.ranges.at(5) = 2.0f;
+  EXPECT_EQ(2, background.apply(laser_scan));
+
+  laser_object_tracker::data_types::LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(laser_scan);
+  laser_object_tracker::segmentation::BreakpointDetection segmentation(0.1);
+  auto segments = segmentation.segment(fragment);
+  ASSERT_EQ(1, segments.size());
+  EXPECT_EQ(2, segments.front().size());
+  EXPECT_NEAR(wall.angle_min + 4 * wall.angle_increment, segments.front().getAngleMin(), test::PRECISION<double>);
+
+  // Different geometry resets the model
+  auto other_scan = test::generateLaserScan(std::vector<float>(12, 5.0f));
+  EXPECT_EQ(12, background.apply(other_scan));
+}
+
+TEST(BackgroundSubtractionTest, UpdatePeriodTest) {
+  laser_object_tracker::segmentation::BackgroundSubtraction background(2, 2, 0.1, 3);
+  auto wall = test::generateLaserScan(std::vector<float>(5, 5.0f));
+
+  // Ranges are recorded in scans 0 and 3, so the wall is background from scan 4 on
+  for (int i = 0; i < 4; ++i) {
+    auto laser_scan = wall;
+    EXPECT_EQ(5, background.apply(laser_scan)) << "Scan " << i;
+  }
+
+  auto laser_scan = wall;
+  EXPECT_EQ(0, background.apply(laser_scan));
+
+  // Beams without return are neither foreground nor background
+  laser_scan = wall;
+  laser_scan.ranges.at(0) = std::numeric_limits<float>::infinity();
+  EXPECT_EQ(0, background.apply(laser_scan));
+  EXPECT_TRUE(std::isinf(laser_scan.ranges.at(0)));
+}
+
+TEST(BackgroundSubtractionTest, SnapshotTest) {
+  laser_object_tracker::segmentation::BackgroundSubtraction background(4, 3, 0.1, 1);
+  auto wall = test::generateLaserScan(std::vector<float>(10, 5.0f), -M_PI, M_PI, "laser");
+  for (int i = 0; i < 4; ++i) {
+    auto laser_scan = wall;
+    background.apply(laser_scan);
+  }
+
+  std::string path = testing::TempDir() + "background_subtraction_test.bin";
+  ASSERT_TRUE(background.save(path));
+
+  // Restarted model removes background from the very first scan
+  laser_object_tracker::segmentation::BackgroundSubtraction restored(4, 3, 0.1, 1);
+  ASSERT_TRUE(restored.load(path));
+  auto laser_scan = wall;
+  EXPECT_EQ(0, restored.apply(laser_scan));
+
+  // Snapshot of a different scanner is not used
+  ASSERT_TRUE(restored.load(path));
+  laser_scan = test::generateLaserScan(std::vector<float>(10, 5.0f), -M_PI, M_PI, "other_laser");
+  EXPECT_EQ(10, restored.apply(laser_scan));
+
+  laser_object_tracker::segmentation::BackgroundSubtraction other_history(8, 3, 0.1, 1);
+  EXPECT_FALSE(other_history.load(path));
+  EXPECT_FALSE(restored.load(path + ".missing"));
+
+  {
+    std::ofstream truncated(path, std::ios::binary | std::ios::trunc);
+    truncated << "LOTBGM1";
+  }
+  EXPECT_FALSE(restored.load(path));
+
+  // Header alone, with number of beams making the expected size overflow to the header size
+  ASSERT_TRUE(background.save(path));
+  std::string header;
+  {
+    std::ifstream file(path, std::ios::binary);
+    header.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  const int64_t beams_number = int64_t(1) << 62;
+  header.replace(72, sizeof(beams_number), reinterpret_cast<const char*>(&beams_number), sizeof(beams_number));
+  header.resize(header.size() - 10 * 4 * sizeof(float));
+  {
+    std::ofstream corrupted(path, std::ios::binary | std::ios::trunc);
+    corrupted << header;
+  }
+  EXPECT_FALSE(restored.load(path));
+  std::remove(path.c_str());
+}
+
+TEST(BackgroundSubtractionTest, SaveAsyncTest) {
+  std::string path = testing::TempDir() + "background_subtraction_async_test.bin";
+  auto wall = test::generateLaserScan(std::vector<float>(10, 5.0f), -M_PI, M_PI, "laser");
+  {
+    laser_object_tracker::segmentation::BackgroundSubtraction background(4, 3, 0.1, 1);
+    for (int i = 0; i < 4; ++i) {
+      auto laser_scan = wall;
+      background.apply(laser_scan);
+    }
+
+    EXPECT_TRUE(background.saveAsync(path));
+    EXPECT_TRUE(background.waitForSnapshot());
+
+    // Failure of a snapshot is reported by the following request
+    EXPECT_TRUE(background.saveAsync(path + ".missing/background.bin"));
+    EXPECT_FALSE(background.waitForSnapshot());
+    EXPECT_FALSE(background.saveAsync(path));
+
+    // Pending snapshot is finished before the model is destroyed
+  }
+
+  laser_object_tracker::segmentation::BackgroundSubtraction restored(4, 3, 0.1, 1);
+  ASSERT_TRUE(restored.load(path));
+  auto laser_scan = wall;
+  EXPECT_EQ(0, restored.apply(laser_scan));
+  std::remove(path.c_str());
+}
@@ -0,0 +1,234 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "laser_object_tracker/filtering/occlusion_detection.hpp"
+#include "laser_object_tracker/segmentation/adaptive_breakpoint_detection.hpp"
+#include "laser_object_tracker/segmentation/breakpoint_detection.hpp"
+#include "laser_object_tracker/segmentation/chunked_segmentation.hpp"
+
+#include "test/utils.hpp"
+
+namespace {
+/**
+ * @brief Scan of piecewise constant ranges with occasional invalid beams, so that segments straddle chunk seams.
+ */
+laser_object_tracker::data_types::LaserScanType generateRandomScan(int beams) {
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> range_distribution(1.0f, 9.0f);
+  std::uniform_int_distribution<int> length_distribution(1, 300);
+  std::bernoulli_distribution invalid_distribution(0.02);
+
+  std::vector<float> ranges;
+  while (ranges.size() < beams) {
+    float range = range_distribution(generator);
+    for (int i = length_distribution(generator); i > 0 && ranges.size() < beams; --i) {
+      ranges.push_back(invalid_distribution(generator) ? 20.0f : range + 0.001f * i);
+    }
+  }
+
+  return test::generateLaserScan(ranges);
+}
+}  // namespace
+
+TEST(ChunkedSegmentationTest, AccessorsTest) {
+  laser_object_tracker::segmentation::ChunkedSegmentation segmentation(4, 100);
+  EXPECT_EQ(4, segmentation.getChunksNumber());
+  EXPECT_EQ(100, segmentation.getMinChunkSize());
+
+  EXPECT_THROW(segmentation.setChunksNumber(0), std::invalid_argument);
+  EXPECT_THROW(segmentation.setMinChunkSize(0), std::invalid_argument);
+
+  laser_object_tracker::segmentation::BreakpointDetection detection(0.1);
+  EXPECT_EQ(1, detection.getChunksNumber());
+  detection.setChunksNumber(3);
+  EXPECT_EQ(3, detection.getChunksNumber());
+
+  EXPECT_FALSE(detection.getWrapAround());
+  detection.setWrapAround(true);
+  EXPECT_TRUE(detection.getWrapAround());
+}
+
+TEST(ChunkedSegmentationTest, SeamTest) {
+  using laser_object_tracker::data_types::LaserScanFragment;
+  laser_object_tracker::segmentation::ChunkedSegmentation segmentation(4, 1);
+
+  // Single segment covering every chunk, then breakpoints exactly at seams
+  LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(test::generateLaserScan(std::vector<float>(8, 1.0f)));
+  std::vector<LaserScanFragment> segments;
+  auto never = [](const auto&, const auto&) {return false;};
+  segmentation.segment(fragment, segments, never);
+  ASSERT_EQ(1, segments.size());
+  EXPECT_EQ(8, segments.front().size());
+
+  fragment = factory.fromLaserScan(test::generateLaserScan({1.0, 1.0, 2.0, 2.0, 3.0, 3.0, 4.0, 4.0}));
+  segmentation.segment(fragment, segments, [](const auto& previous, const auto& current) {
+    return previous.range() != current.range();
+  });
+  ASSERT_EQ(4, segments.size());
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(2, segments.at(i).size());
+    EXPECT_NEAR(i + 1.0, segments.at(i).front().range(), test::PRECISION<double>);
+  }
+}
+
+TEST(ChunkedSegmentationTest, ExceptionTest) {
+  using laser_object_tracker::data_types::LaserScanFragment;
+  laser_object_tracker::segmentation::ChunkedSegmentation segmentation(4, 1);
+
+  LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(test::generateLaserScan({1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0}));
+  std::vector<LaserScanFragment> segments;
+
+  // Chunk on the calling thread and one on another thread fail, remaining chunks are joined before rethrowing
+  for (float failing_range : {2.0f, 6.0f}) {
+    EXPECT_THROW(segmentation.segment(fragment, segments, [failing_range](const auto& previous, const auto& current) {
+      if (current.range() == failing_range) {
+        throw std::runtime_error("Breakpoint failure");
+      }
+      return true;
+    }), std::runtime_error);
+  }
+
+  segmentation.segment(fragment, segments, [](const auto&, const auto&) {return true;});
+  EXPECT_EQ(8, segments.size());
+}
+
+TEST(ChunkedSegmentationTest, IdenticalToSerialTest) {
+  using laser_object_tracker::data_types::LaserScanFragment;
+  LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(generateRandomScan(5000));
+
+  laser_object_tracker::segmentation::BreakpointDetection breakpoint(0.2);
+  laser_object_tracker::segmentation::AdaptiveBreakpointDetection adaptive(0.1, 0.01);
+  std::vector<laser_object_tracker::segmentation::BaseSegmentation*> detections{&breakpoint, &adaptive};
+
+  for (auto detection : detections) {
+    std::vector<LaserScanFragment> serial, chunked;
+    detection->segment(fragment, serial);
+    ASSERT_LT(10, serial.size());
+
+    breakpoint.setChunksNumber(4);
+    adaptive.setChunksNumber(4);
+    detection->segment(fragment, chunked);
+    EXPECT_EQ(serial, chunked);
+
+    breakpoint.setChunksNumber(1);
+    adaptive.setChunksNumber(1);
+  }
+}
+
+TEST(ChunkedSegmentationTest, WrapAroundTest) {
+  using laser_object_tracker::data_types::LaserScanFragment;
+  laser_object_tracker::segmentation::ChunkedSegmentation segmentation(2, 1);
+  auto is_breakpoint = [](const auto& previous, const auto& current) {
+    return previous.range() != current.range();
+  };
+
+  // Full revolution, last beam is a neighbour of the first one
+  std::vector<float> ranges{1.0, 1.0, 2.0, 2.0, 3.0, 3.0, 1.0, 1.0};
+  LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(test::generateLaserScan(ranges, -M_PI, M_PI - 2.0 * M_PI / ranges.size()));
+  std::vector<LaserScanFragment> segments;
+  segmentation.segment(fragment, segments, is_breakpoint);
+  EXPECT_EQ(4, segments.size());
+
+  segmentation.setWrapAround(true);
+  segmentation.segment(fragment, segments, is_breakpoint);
+  ASSERT_EQ(3, segments.size());
+  const auto& merged = segments.back();
+  ASSERT_EQ(4, merged.size());
+  EXPECT_NEAR(fragment.at(6).getAngle(), merged.getAngleMin(), test::PRECISION<double>);
+  for (int i = 0; i < merged.size(); ++i) {
+    EXPECT_NEAR(1.0, merged.at(i).range(), test::PRECISION<double>);
+    EXPECT_NEAR(merged.getAngleMin() + i * merged.getAngleIncrement(), merged.at(i).getAngle(), test::PRECISION<double>);
+  }
+  EXPECT_NEAR(fragment.at(0).point().x, merged.at(2).point().x, test::PRECISION<double>);
+  EXPECT_NEAR(fragment.at(1).point().y, merged.at(3).point().y, test::PRECISION<double>);
+
+  // Breakpoint across the seam
+  ranges.back() = 2.0;
+  fragment = factory.fromLaserScan(test::generateLaserScan(ranges, -M_PI, M_PI - 2.0 * M_PI / ranges.size()));
+  segmentation.segment(fragment, segments, is_breakpoint);
+  EXPECT_EQ(5, segments.size());
+
+  // Invalid beam at the seam
+  ranges.back() = 20.0;
+  fragment = factory.fromLaserScan(test::generateLaserScan(ranges, -M_PI, M_PI - 2.0 * M_PI / ranges.size()));
+  segmentation.segment(fragment, segments, is_breakpoint);
+  EXPECT_EQ(4, segments.size());
+
+  // Ends of a partial scan are not neighbours
+  ranges.back() = 1.0;
+  fragment = factory.fromLaserScan(test::generateLaserScan(ranges, -M_PI_2, M_PI_2));
+  segmentation.segment(fragment, segments, is_breakpoint);
+  EXPECT_EQ(4, segments.size());
+}
+
+TEST(ChunkedSegmentationTest, FusedDescriptorsAndOcclusionsTest) {
+  using laser_object_tracker::data_types::LaserScanFragment;
+  LaserScanFragment::LaserScanFragmentFactory factory;
+  auto fragment = factory.fromLaserScan(generateRandomScan(5000));
+
+  laser_object_tracker::segmentation::BreakpointDetection detection(0.2);
+  std::vector<LaserScanFragment> expected, segments;
+  detection.segment(fragment, expected);
+  laser_object_tracker::filtering::OcclusionDetection(0.05).filter(expected);
+
+  EXPECT_LT(detection.getOcclusionAngleGap(), 0.0);
+  detection.setOcclusionAngleGap(0.05);
+  detection.setChunksNumber(4);
+  detection.segment(fragment, segments);
+  ASSERT_EQ(expected, segments);
+
+  laser_object_tracker::data_types::SegmentDescriptor descriptor;
+  for (int i = 0; i < segments.size(); ++i) {
+    EXPECT_EQ(expected.at(i).front().isOccluded(), segments.at(i).front().isOccluded());
+    EXPECT_EQ(expected.at(i).back().isOccluded(), segments.at(i).back().isOccluded());
+
+    // Descriptor accumulated during segmentation matches one computed from the points of the segment
+    laser_object_tracker::data_types::computeSegmentDescriptor(segments.at(i).pointCloud(), descriptor);
+    const auto& fused = segments.at(i).descriptor();
+    EXPECT_EQ(descriptor.points_number, fused.points_number);
+    EXPECT_TRUE(descriptor.centroid.isApprox(fused.centroid));
+    EXPECT_TRUE(descriptor.covariance.isApprox(fused.covariance));
+    EXPECT_TRUE(descriptor.min.isApprox(fused.min));
+    EXPECT_TRUE(descriptor.max.isApprox(fused.max));
+    EXPECT_DOUBLE_EQ(descriptor.extent, fused.extent);
+    EXPECT_DOUBLE_EQ(descriptor.obb.area(), fused.obb.area());
+  }
+}
@@ -0,0 +1,96 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "laser_object_tracker/tracking/constant_velocity_motion_model.hpp"
+
+#include "test/utils.hpp"
+
+TEST(ConstantVelocityMotionModelTest, ConstructorTest) {
+  EXPECT_THROW(laser_object_tracker::tracking::ConstantVelocityMotionModel(0, 1.0), std::invalid_argument);
+  EXPECT_THROW(laser_object_tracker::tracking::ConstantVelocityMotionModel(2, -1.0), std::invalid_argument);
+  EXPECT_THROW(laser_object_tracker::tracking::ConstantVelocityMotionModel(2, 1.0, -1.0), std::invalid_argument);
+
+  laser_object_tracker::tracking::ConstantVelocityMotionModel motion_model(2, 0.5);
+  EXPECT_EQ(2, motion_model.getDimensions());
+  EXPECT_NEAR(0.5, motion_model.getAccelerationNoise(), test::PRECISION<double>);
+  EXPECT_NEAR(0.0, motion_model.getPositionNoise(), test::PRECISION<double>);
+}
+
+TEST(ConstantVelocityMotionModelTest, DiscretizeTest) {
+  laser_object_tracker::tracking::ConstantVelocityMotionModel motion_model(2, 2.0);
+
+  Eigen::MatrixXd transition_matrix, process_noise_covariance;
+  motion_model.discretize(0.5, transition_matrix, process_noise_covariance);
+
+  Eigen::MatrixXd expected_transition(4, 4);
+  expected_transition << 1.0, 0.0, 0.5, 0.0,
+                         0.0, 1.0, 0.0, 0.5,
+                         0.0, 0.0, 1.0, 0.0,
+                         0.0, 0.0, 0.0, 1.0;
+  EXPECT_TRUE(expected_transition.isApprox(transition_matrix, test::PRECISION<double>))
+      << "Expected transition matrix is:\n" << expected_transition << std::endl
+      << "but actual is:\n" << transition_matrix;
+
+  // q * [dt^3 / 3, dt^2 / 2; dt^2 / 2, dt] for each axis
+  Eigen::MatrixXd expected_covariance(4, 4);
+  expected_covariance << 1.0 / 12.0, 0.0, 0.25, 0.0,
+                         0.0, 1.0 / 12.0, 0.0, 0.25,
+                         0.25, 0.0, 1.0, 0.0,
+                         0.0, 0.25, 0.0, 1.0;
+  EXPECT_TRUE(expected_covariance.isApprox(process_noise_covariance, test::PRECISION<double>))
+      << "Expected process noise covariance is:\n" << expected_covariance << std::endl
+      << "but actual is:\n" << process_noise_covariance;
+
+  motion_model.discretize(0.0, transition_matrix, process_noise_covariance);
+  EXPECT_TRUE(transition_matrix.isIdentity());
+  EXPECT_TRUE(process_noise_covariance.isZero());
+}
+
+TEST(ConstantVelocityMotionModelTest, NodeTuningTest) {
+  // Noise densities of config/tracker.yaml, matching the former fixed Q = 0.1 * I at 10 Hz up to the cross terms
+  laser_object_tracker::tracking::ConstantVelocityMotionModel motion_model(2, 1.0, 1.0);
+
+  Eigen::MatrixXd transition_matrix, process_noise_covariance;
+  motion_model.discretize(0.1, transition_matrix, process_noise_covariance);
+
+  Eigen::MatrixXd expected_covariance(4, 4);
+  expected_covariance << 0.1 + 1.0 / 3000.0, 0.0, 0.005, 0.0,
+                         0.0, 0.1 + 1.0 / 3000.0, 0.0, 0.005,
+                         0.005, 0.0, 0.1, 0.0,
+                         0.0, 0.005, 0.0, 0.1;
+  EXPECT_TRUE(expected_covariance.isApprox(process_noise_covariance, 1e-9))
+      << "Expected process noise covariance is:\n" << expected_covariance << std::endl
+      << "but actual is:\n" << process_noise_covariance;
+}
@@ -77,3 +77,21 @@ TEST(IterationTrackerRejectionTest, InvalidationTest) {
   rejection.notUpdated(tracking);
   EXPECT_TRUE(rejection.invalidate(tracking));
 }
+
+TEST(IterationTrackerRejectionTest, ResetFromTest) {
+  laser_object_tracker::tracking::IterationTrackerRejection prototype(1);
+  laser_object_tracker::tracking::IterationTrackerRejection rejection(3);
+
+  test::MockTracking tracking;
+  for (int i = 0; i < 4; ++i) {
+    rejection.notUpdated(tracking);
+  }
+  EXPECT_TRUE(rejection.invalidate(tracking));
+
+  rejection.resetFrom(prototype);
+  EXPECT_FALSE(rejection.invalidate(tracking));
+  EXPECT_EQ(1, rejection.getMaxIterationsWithoutUpdate());
+
+  test::MockTrackerRejection other_rejection;
+  EXPECT_THROW(rejection.resetFrom(other_rejection), std::bad_cast);
+}
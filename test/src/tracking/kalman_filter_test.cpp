@@ -33,9 +33,11 @@
 
 #include <gtest/gtest.h>
 
+#include "laser_object_tracker/tracking/constant_velocity_motion_model.hpp"
 #include "laser_object_tracker/tracking/kalman_filter.hpp"
 
 #include "test/utils.hpp"
+#include "test/tracking/mocks.hpp"
 
 TEST(KalmanFilterTest, InitFromStateTest) {
   Eigen::MatrixXd empty_matrix;
@@ -103,4 +105,73 @@ TEST(KalmanFilterTest, InitFromMeasurementTest) {
   EXPECT_TRUE(expected_state.isApprox(state_vector, test::PRECISION<double>))
             << "Expected state vector is:\n" << expected_state << std::endl
             << "but actual is:\n" << state_vector;
-}
\ No newline at end of file
+}
+
+TEST(KalmanFilterTest, ResetFromTest) {
+  Eigen::MatrixXd identity = Eigen::MatrixXd::Identity(4, 4);
+  Eigen::MatrixXd measurement_matrix(2, 4);
+  measurement_matrix << 1.0, 0.0, 0.0, 0.0,
+                        0.0, 1.0, 0.0, 0.0;
+  laser_object_tracker::tracking::KalmanFilter prototype(4, 2,
+                                                         identity,
+                                                         measurement_matrix,
+                                                         Eigen::MatrixXd::Identity(2, 2),
+                                                         identity,
+                                                         identity);
+  auto filter = prototype.clone();
+
+  Eigen::VectorXd measurement(2);
+  measurement << 21.0, 32.0;
+  filter->initFromMeasurement(measurement);
+  filter->predict();
+  filter->update(measurement);
+
+  filter->resetFrom(prototype);
+  Eigen::VectorXd expected_state = prototype.getStateVector();
+  Eigen::VectorXd state_vector = filter->getStateVector();
+  EXPECT_TRUE(expected_state.isApprox(state_vector, test::PRECISION<double>))
+            << "Expected state vector is:\n" << expected_state << std::endl
+            << "but actual is:\n" << state_vector;
+
+  test::MockTracking other_tracker;
+  EXPECT_THROW(filter->resetFrom(other_tracker), std::bad_cast);
+}
+
+TEST(KalmanFilterTest, PredictWithTimeStepTest) {
+  Eigen::MatrixXd identity = Eigen::MatrixXd::Identity(4, 4);
+  Eigen::MatrixXd measurement_matrix(2, 4);
+  measurement_matrix << 1.0, 0.0, 0.0, 0.0,
+                        0.0, 1.0, 0.0, 0.0;
+  laser_object_tracker::tracking::KalmanFilter filter(4, 2,
+                                                      identity,
+                                                      measurement_matrix,
+                                                      Eigen::MatrixXd::Identity(2, 2),
+                                                      identity,
+                                                      identity);
+
+  Eigen::VectorXd state(4);
+  state << 1.0, 2.0, 3.0, -4.0;
+  filter.initFromState(state);
+  // Without motion model cache the constant transition matrix is used
+  filter.predict(0.5);
+  Eigen::VectorXd expected_state = state;
+  Eigen::VectorXd state_vector = filter.getStateVector();
+  EXPECT_TRUE(expected_state.isApprox(state_vector, test::PRECISION<double>))
+            << "Expected state vector is:\n" << expected_state << std::endl
+            << "but actual is:\n" << state_vector;
+
+  filter.setMotionModelCache(std::make_shared<laser_object_tracker::tracking::MotionModelCache>(
+      std::make_unique<laser_object_tracker::tracking::ConstantVelocityMotionModel>(2, 1.0), 0.001, 16));
+  auto clone = filter.clone();
+
+  filter.initFromState(state);
+  filter.predict(0.5);
+  clone->initFromState(state);
+  clone->predict(0.5);
+  expected_state << 2.5, 0.0, 3.0, -4.0;
+  for (const auto& state_vector : {filter.getStateVector(), clone->getStateVector()}) {
+    EXPECT_TRUE(expected_state.isApprox(state_vector, test::PRECISION<double>))
+              << "Expected state vector is:\n" << expected_state << std::endl
+              << "but actual is:\n" << state_vector;
+  }
+}
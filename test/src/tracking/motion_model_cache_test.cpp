@@ -0,0 +1,92 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "laser_object_tracker/tracking/constant_velocity_motion_model.hpp"
+#include "laser_object_tracker/tracking/motion_model_cache.hpp"
+
+#include "test/utils.hpp"
+
+namespace {
+class MockMotionModel : public laser_object_tracker::tracking::BaseMotionModel {
+ public:
+  MOCK_CONST_METHOD3(discretize, void(double, Eigen::MatrixXd&, Eigen::MatrixXd&));
+};
+}  // namespace
+
+TEST(MotionModelCacheTest, ConstructorTest) {
+  using laser_object_tracker::tracking::MotionModelCache;
+  EXPECT_THROW(MotionModelCache(nullptr, 0.001, 8), std::invalid_argument);
+  EXPECT_THROW(MotionModelCache(std::make_unique<MockMotionModel>(), 0.0, 8), std::invalid_argument);
+  EXPECT_THROW(MotionModelCache(std::make_unique<MockMotionModel>(), 0.001, 0), std::invalid_argument);
+
+  MotionModelCache cache(std::make_unique<MockMotionModel>(), 0.001, 8);
+  EXPECT_NEAR(0.001, cache.getTimeStepQuantum(), test::PRECISION<double>);
+  EXPECT_EQ(8, cache.size());
+  EXPECT_THROW(cache.get(-0.1), std::invalid_argument);
+}
+
+TEST(MotionModelCacheTest, CachingTest) {
+  auto motion_model = std::make_unique<MockMotionModel>();
+  auto& motion_model_ref = *motion_model;
+  laser_object_tracker::tracking::MotionModelCache cache(std::move(motion_model), 0.01, 4);
+
+  testing::InSequence sequence;
+  // Time steps are quantized before discretization
+  EXPECT_CALL(motion_model_ref, discretize(testing::DoubleNear(0.1, 1e-9), testing::_, testing::_)).Times(1);
+  EXPECT_CALL(motion_model_ref, discretize(testing::DoubleNear(0.14, 1e-9), testing::_, testing::_)).Times(1);
+  // 0.1 and 0.14 share a slot in a table of size 4, hence 0.1 is evicted
+  EXPECT_CALL(motion_model_ref, discretize(testing::DoubleNear(0.1, 1e-9), testing::_, testing::_)).Times(1);
+
+  EXPECT_NEAR(0.1, cache.get(0.1).time_step, test::PRECISION<double>);
+  EXPECT_NEAR(0.1, cache.get(0.1012).time_step, test::PRECISION<double>);
+  EXPECT_NEAR(0.1, cache.get(0.0996).time_step, test::PRECISION<double>);
+  EXPECT_NEAR(0.14, cache.get(0.14).time_step, test::PRECISION<double>);
+  EXPECT_NEAR(0.1, cache.get(0.1).time_step, test::PRECISION<double>);
+}
+
+TEST(MotionModelCacheTest, ValuesTest) {
+  laser_object_tracker::tracking::MotionModelCache cache(
+      std::make_unique<laser_object_tracker::tracking::ConstantVelocityMotionModel>(2, 1.0), 0.001, 16);
+  laser_object_tracker::tracking::ConstantVelocityMotionModel motion_model(2, 1.0);
+
+  Eigen::MatrixXd transition_matrix, process_noise_covariance;
+  for (double time_step : {0.025, 0.04, 0.1, 0.025}) {
+    motion_model.discretize(time_step, transition_matrix, process_noise_covariance);
+    const auto& entry = cache.get(time_step);
+    EXPECT_TRUE(transition_matrix.isApprox(entry.transition_matrix));
+    EXPECT_TRUE(process_noise_covariance.isApprox(entry.process_noise_covariance));
+  }
+}
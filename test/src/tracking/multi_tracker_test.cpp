@@ -33,6 +33,9 @@
 
 #include <gtest/gtest.h>
 
+#include "laser_object_tracker/data_association/hungarian_algorithm.hpp"
+#include "laser_object_tracker/data_association/murty_algorithm.hpp"
+#include "laser_object_tracker/tracking/iteration_tracker_rejection.hpp"
 #include "laser_object_tracker/tracking/multi_tracker.hpp"
 
 #include "test/utils.hpp"
@@ -86,3 +89,158 @@ TEST(MultiTrackerTest, UpdateAndInitializeTracksTest) {
 
   multi_tracker.updateAndInitializeTracks(measurements, assignment_vector);
 }
+
+TEST(MultiTrackerTest, AssignmentHypothesesTest) {
+  auto tracking = std::make_unique<test::MockTracking>();
+  auto tracker_rejection = std::make_unique<test::MockTrackerRejection>();
+  laser_object_tracker::tracking::MultiTracker multi_tracker(
+      [](const auto& lhs, const auto& rhs) {return 0.0;},
+      std::make_unique<laser_object_tracker::data_association::MurtyAlgorithm>(),
+      std::move(tracking),
+      std::move(tracker_rejection));
+
+  EXPECT_THROW(multi_tracker.setMaxHypotheses(0, 0.0), std::invalid_argument);
+  EXPECT_THROW(multi_tracker.setMaxHypotheses(2, -1.0), std::invalid_argument);
+
+  static constexpr int AMBIGUOUS_ASSIGNMENT = laser_object_tracker::tracking::MultiTracker::AMBIGUOUS_ASSIGNMENT;
+
+  // First two tracks compete for first two measurements, third one is unambiguous
+  Eigen::MatrixXd cost_matrix(3, 3);
+  cost_matrix << 1.0, 1.1, 9.0,
+                 1.1, 1.0, 9.0,
+                 9.0, 9.0, 1.0;
+
+  Eigen::VectorXi expected_assignment(3);
+  expected_assignment << 0, 1, 2;
+  EXPECT_EQ(expected_assignment, multi_tracker.buildAssignmentVector(cost_matrix));
+
+  multi_tracker.setMaxHypotheses(5, 0.1);
+  EXPECT_EQ(expected_assignment, multi_tracker.buildAssignmentVector(cost_matrix));
+
+  multi_tracker.setMaxHypotheses(5, 0.5);
+  expected_assignment << AMBIGUOUS_ASSIGNMENT, AMBIGUOUS_ASSIGNMENT, 2;
+  EXPECT_EQ(expected_assignment, multi_tracker.buildAssignmentVector(cost_matrix));
+
+  std::vector<Eigen::VectorXd> measurements(3);
+  expected_assignment << AMBIGUOUS_ASSIGNMENT, AMBIGUOUS_ASSIGNMENT, AMBIGUOUS_ASSIGNMENT;
+  // Ambiguous measurements do not initialize new tracks
+  multi_tracker.updateAndInitializeTracks(measurements, expected_assignment);
+  EXPECT_EQ(0, multi_tracker.size());
+}
+
+TEST(MultiTrackerTest, InfeasibleHypothesesTest) {
+  auto tracking = std::make_unique<test::MockTracking>();
+  auto tracker_rejection = std::make_unique<test::MockTrackerRejection>();
+  laser_object_tracker::tracking::MultiTracker multi_tracker(
+      [](const auto& lhs, const auto& rhs) {return 0.0;},
+      std::make_unique<laser_object_tracker::data_association::MurtyAlgorithm>(5.0),
+      std::move(tracking),
+      std::move(tracker_rejection));
+  multi_tracker.setMaxHypotheses(5, 0.5);
+
+  // First track cannot be assigned at all, so there is no complete assignment
+  static constexpr double INF = std::numeric_limits<double>::infinity();
+  Eigen::MatrixXd cost_matrix(2, 2);
+  cost_matrix << INF, INF,
+                 1.0, 2.0;
+
+  Eigen::VectorXi assignment_vector = multi_tracker.buildAssignmentVector(cost_matrix);
+  ASSERT_EQ(2, assignment_vector.size());
+  EXPECT_EQ(Eigen::VectorXi::Constant(2, laser_object_tracker::data_association::BaseDataAssociation::NO_ASSIGNMENT),
+            assignment_vector);
+
+  std::vector<double> costs;
+  EXPECT_THROW(multi_tracker.resolveAssignmentHypotheses({}, costs), std::invalid_argument);
+}
+
+TEST(MultiTrackerTest, FrameArenaUpdateTest) {
+  auto tracking = std::make_unique<test::MockTracking>();
+  auto tracker_rejection = std::make_unique<test::MockTrackerRejection>();
+  laser_object_tracker::tracking::MultiTracker multi_tracker(
+      [](const Eigen::VectorXd& measurement, const auto& tracker) {return measurement(0);},
+      std::make_unique<laser_object_tracker::data_association::HungarianAlgorithm>(),
+      std::move(tracking),
+      std::move(tracker_rejection));
+
+  laser_object_tracker::data_types::FrameArena frame_arena;
+  multi_tracker.setFrameArena(&frame_arena);
+
+  std::vector<Eigen::VectorXd> measurements(3, Eigen::VectorXd::Zero(2));
+  multi_tracker.update(measurements);
+  EXPECT_EQ(3, multi_tracker.size());
+  frame_arena.reset();
+
+  // Cost matrix of the second frame is built in the arena and every measurement updates an existing track
+  multi_tracker.update(measurements);
+  EXPECT_EQ(3, multi_tracker.size());
+  frame_arena.reset();
+
+  multi_tracker.update(measurements);
+  EXPECT_EQ(3, multi_tracker.size());
+  EXPECT_EQ(3 * 3 * sizeof(double), frame_arena.used());
+}
+
+TEST(MultiTrackerTest, HandleRejectedTracksTest) {
+  auto data_association = std::make_unique<test::MockDataAssociation>();
+  auto tracking = std::make_unique<test::MockTracking>();
+  // Tracks are rejected after a single iteration without update
+  auto tracker_rejection = std::make_unique<laser_object_tracker::tracking::IterationTrackerRejection>(0);
+  laser_object_tracker::tracking::MultiTracker multi_tracker(
+      [](const auto& lhs, const auto& rhs) {return 0.0;},
+      std::move(data_association),
+      std::move(tracking),
+      std::move(tracker_rejection));
+
+  static constexpr int NO_ASSIGNMENT = laser_object_tracker::data_association::BaseDataAssociation::NO_ASSIGNMENT;
+
+  std::vector<Eigen::VectorXd> measurements(6);
+  Eigen::VectorXi assignment_vector;
+  assignment_vector.setConstant(6, NO_ASSIGNMENT);
+  multi_tracker.updateAndInitializeTracks(measurements, assignment_vector);
+  ASSERT_EQ(6, multi_tracker.size());
+
+  std::vector<const laser_object_tracker::tracking::BaseTracking*> trackers;
+  for (const auto& tracker : multi_tracker) {
+    trackers.push_back(tracker.get());
+  }
+
+  measurements.resize(3);
+  assignment_vector.resize(3);
+  assignment_vector << 4, NO_ASSIGNMENT, 1;
+  multi_tracker.handleNotUpdatedTracks(assignment_vector);
+  multi_tracker.handleRejectedTracks();
+
+  // Surviving tracks keep their relative order
+  ASSERT_EQ(2, multi_tracker.size());
+  EXPECT_EQ(trackers.at(1), &multi_tracker.at(0));
+  EXPECT_EQ(trackers.at(4), &multi_tracker.at(1));
+
+  assignment_vector.resize(0);
+  multi_tracker.handleNotUpdatedTracks(assignment_vector);
+  multi_tracker.handleRejectedTracks();
+  EXPECT_EQ(0, multi_tracker.size());
+}
+
+TEST(MultiTrackerTest, PredictTest) {
+  auto data_association = std::make_unique<test::MockDataAssociation>();
+  auto tracking = std::make_unique<test::MockTracking>();
+  auto tracker_rejection = std::make_unique<test::MockTrackerRejection>();
+  laser_object_tracker::tracking::MultiTracker multi_tracker(
+      [](const auto& lhs, const auto& rhs) {return 0.0;},
+      std::move(data_association),
+      std::move(tracking),
+      std::move(tracker_rejection));
+
+  std::vector<Eigen::VectorXd> measurements(3);
+  Eigen::VectorXi assignment_vector;
+  assignment_vector.setConstant(3, laser_object_tracker::data_association::BaseDataAssociation::NO_ASSIGNMENT);
+  multi_tracker.updateAndInitializeTracks(measurements, assignment_vector);
+
+  for (const auto& tracker : multi_tracker) {
+    auto& cast_tracker = dynamic_cast<test::MockTracking&>(*tracker);
+    EXPECT_CALL(cast_tracker, predict(0.04));
+    EXPECT_CALL(cast_tracker, predict()).Times(0);
+  }
+
+  multi_tracker.predict(0.04);
+}
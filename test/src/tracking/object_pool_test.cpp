@@ -0,0 +1,85 @@
+/*********************************************************************
+*
+* BSD 3-Clause License
+*
+*  Copyright (c) 2019, Piotr Pokorski
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions are met:
+*
+*  1. Redistributions of source code must retain the above copyright notice, this
+*     list of conditions and the following disclaimer.
+*
+*  2. Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+*
+*  3. Neither the name of the copyright holder nor the names of its
+*     contributors may be used to endorse or promote products derived from
+*     this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+*  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+*  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+*  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+*  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+*  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+*  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+*  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "laser_object_tracker/tracking/object_pool.hpp"
+
+#include "test/tracking/mocks.hpp"
+
+TEST(ObjectPoolTest, EmptyPrototypeTest) {
+  EXPECT_THROW(laser_object_tracker::tracking::ObjectPool<laser_object_tracker::tracking::BaseTracking> pool(nullptr),
+               std::invalid_argument);
+}
+
+TEST(ObjectPoolTest, AcquireReleaseTest) {
+  laser_object_tracker::tracking::ObjectPool<laser_object_tracker::tracking::BaseTracking> pool(
+      std::make_unique<test::MockTracking>());
+  EXPECT_EQ(0, pool.available());
+
+  auto first = pool.acquire();
+  auto second = pool.acquire();
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  EXPECT_NE(first, second);
+  EXPECT_NE(&pool.prototype(), first.get());
+  EXPECT_EQ(0, pool.available());
+
+  auto* first_pointer = first.get();
+  pool.release(std::move(first));
+  pool.release(nullptr);
+  EXPECT_EQ(1, pool.available());
+
+  // Released object is reused and reinitialized from prototype
+  EXPECT_CALL(dynamic_cast<test::MockTracking&>(*first_pointer), resetFrom(testing::Ref(pool.prototype())));
+  auto third = pool.acquire();
+  EXPECT_EQ(first_pointer, third.get());
+  EXPECT_EQ(0, pool.available());
+}
+
+TEST(ObjectPoolTest, ReserveTest) {
+  laser_object_tracker::tracking::ObjectPool<laser_object_tracker::tracking::BaseTracking> pool(
+      std::make_unique<test::MockTracking>());
+
+  pool.reserve(3);
+  EXPECT_EQ(3, pool.available());
+
+  auto first = pool.acquire();
+  EXPECT_EQ(2, pool.available());
+
+  // Outstanding objects count towards reserved size
+  pool.reserve(3);
+  EXPECT_EQ(2, pool.available());
+  pool.reserve(4);
+  EXPECT_EQ(3, pool.available());
+}